@@ -0,0 +1,231 @@
+// Formato binário de tabuleiros e frotas (parte da biblioteca libbatalhanaval.a)
+// Separado do motor, que não faz nenhuma entrada e saída: grava e lê registros binários em disco.
+
+#define _POSIX_C_SOURCE 200809L // Para posix_madvise
+
+#include <stdlib.h>   // Para malloc/free
+#include <string.h>   // Para memcpy e memcmp
+#include <unistd.h>   // Para close
+#include <fcntl.h>    // Para open no leitor de arquivos binários
+#include <sys/mman.h> // Para mapear arquivos binários na memória (mmap)
+#include <sys/stat.h> // Para obter o tamanho do arquivo mapeado
+
+#include "batalhaNaval.h"
+
+// --- Formato Binário de Tabuleiros e Frotas ---
+
+// Funções auxiliares de codificação little-endian (independentes da arquitetura)
+static void gravarU16(uint8_t *destino, uint16_t valor) {
+    destino[0] = (uint8_t)valor;
+    destino[1] = (uint8_t)(valor >> 8);
+}
+
+static uint16_t lerU16(const uint8_t *origem) {
+    return (uint16_t)(origem[0] | origem[1] << 8);
+}
+
+static void gravarU64(uint8_t *destino, uint64_t valor) {
+    for (int i = 0; i < 8; i++) {
+        destino[i] = (uint8_t)(valor >> (8 * i));
+    }
+}
+
+static uint64_t lerU64(const uint8_t *origem) {
+    uint64_t valor = 0;
+    for (int i = 0; i < 8; i++) {
+        valor |= (uint64_t)origem[i] << (8 * i);
+    }
+    return valor;
+}
+
+static void gravarMascara(uint8_t *destino, Bitboard mascara) {
+    for (int i = 0; i < BYTES_MASCARA; i++) {
+        destino[i] = (uint8_t)(mascara >> (8 * i));
+    }
+}
+
+static Bitboard lerMascara(const uint8_t *origem) {
+    Bitboard mascara = 0;
+    for (int i = 0; i < BYTES_MASCARA; i++) {
+        mascara |= (Bitboard)origem[i] << (8 * i);
+    }
+    return mascara & ~BITBOARD_GUARDA;
+}
+
+// Função auxiliar para o tamanho em bytes de um registro
+size_t bytesRegistro(TipoRegistro tipo, int navios_por_registro) {
+    return tipo == REGISTRO_BITBOARD ? 2 * BYTES_MASCARA : 2 * (size_t)navios_por_registro;
+}
+
+// Função auxiliar para montar o cabeçalho do arquivo
+static void montarCabecalho(uint8_t cabecalho[ARQUIVO_CABECALHO], const EscritorRegistros *escritor) {
+    memset(cabecalho, 0, ARQUIVO_CABECALHO);
+    memcpy(cabecalho, ARQUIVO_MAGICO, 4);
+    gravarU16(cabecalho + 4, ARQUIVO_VERSAO);
+    cabecalho[6] = (uint8_t)escritor->tipo;
+    cabecalho[7] = TABULEIRO_TAMANHO;
+    gravarU16(cabecalho + 8, (uint16_t)escritor->navios_por_registro);
+    gravarU16(cabecalho + 10, (uint16_t)bytesRegistro(escritor->tipo, escritor->navios_por_registro));
+    gravarU64(cabecalho + 12, escritor->quantidade);
+}
+
+// Função para criar um arquivo de registros para escrita
+// 'navios_por_registro' só é usado no tipo REGISTRO_NAVIOS. Retorna false em caso de erro.
+#define BUFFER_ESCRITOR (1 << 20) // 1 MiB de buffer de escrita
+bool abrirEscritor(EscritorRegistros *escritor, const char *caminho, TipoRegistro tipo, int navios_por_registro) {
+    uint8_t cabecalho[ARQUIVO_CABECALHO];
+
+    if ((tipo != REGISTRO_BITBOARD && tipo != REGISTRO_NAVIOS) ||
+        (tipo == REGISTRO_NAVIOS && (navios_por_registro < 1 || navios_por_registro > MAX_NAVIOS_FROTA))) {
+        return false;
+    }
+    escritor->arquivo = fopen(caminho, "wb");
+    if (escritor->arquivo == NULL) {
+        return false;
+    }
+    setvbuf(escritor->arquivo, NULL, _IOFBF, BUFFER_ESCRITOR);
+    escritor->tipo = tipo;
+    escritor->navios_por_registro = tipo == REGISTRO_NAVIOS ? navios_por_registro : 0;
+    escritor->quantidade = 0;
+
+    // A quantidade de registros é regravada por fecharEscritor
+    montarCabecalho(cabecalho, escritor);
+    return fwrite(cabecalho, 1, ARQUIVO_CABECALHO, escritor->arquivo) == ARQUIVO_CABECALHO;
+}
+
+// Função para gravar um tabuleiro em bitboard (arquivo do tipo REGISTRO_BITBOARD)
+bool escreverTabuleiroBits(EscritorRegistros *escritor, const TabuleiroBits *tabuleiro) {
+    uint8_t registro[2 * BYTES_MASCARA];
+
+    if (escritor->tipo != REGISTRO_BITBOARD) {
+        return false;
+    }
+    gravarMascara(registro, tabuleiro->navios);
+    gravarMascara(registro + BYTES_MASCARA, tabuleiro->habilidades);
+    escritor->quantidade++;
+    return fwrite(registro, 1, sizeof(registro), escritor->arquivo) == sizeof(registro);
+}
+
+// Função para gravar uma frota como lista de navios (arquivo do tipo REGISTRO_NAVIOS)
+// A frota deve ter exatamente 'navios_por_registro' navios.
+bool escreverFrota(EscritorRegistros *escritor, const Frota *frota) {
+    uint8_t registro[2 * MAX_NAVIOS_FROTA];
+
+    if (escritor->tipo != REGISTRO_NAVIOS) {
+        return false;
+    }
+    for (int i = 0; i < escritor->navios_por_registro; i++) {
+        const PosicionamentoNavio *p = posicionamentoPorIndice(frota->posicionamento[i]);
+        registro[2 * i] = (uint8_t)(p->linha | p->coluna << 4);
+        registro[2 * i + 1] = (uint8_t)(p->orientacao | p->tamanho << 2);
+    }
+    escritor->quantidade++;
+    size_t bytes = 2 * (size_t)escritor->navios_por_registro;
+    return fwrite(registro, 1, bytes, escritor->arquivo) == bytes;
+}
+
+// Função para concluir o arquivo: regrava o cabeçalho com a quantidade final e fecha
+bool fecharEscritor(EscritorRegistros *escritor) {
+    uint8_t cabecalho[ARQUIVO_CABECALHO];
+    bool sucesso;
+
+    montarCabecalho(cabecalho, escritor);
+    sucesso = fseek(escritor->arquivo, 0, SEEK_SET) == 0 &&
+              fwrite(cabecalho, 1, ARQUIVO_CABECALHO, escritor->arquivo) == ARQUIVO_CABECALHO;
+    sucesso &= fclose(escritor->arquivo) == 0;
+    escritor->arquivo = NULL;
+    return sucesso;
+}
+
+// Função para liberar o mapeamento do leitor
+void fecharLeitor(LeitorRegistros *leitor) {
+    if (leitor->dados != NULL) {
+        munmap((void *)leitor->dados, leitor->tamanho_mapa);
+        leitor->dados = NULL;
+    }
+}
+
+// Função para abrir um arquivo de registros mapeando-o na memória
+// Valida o cabeçalho; registros incompletos no final (arquivo truncado) são ignorados.
+bool abrirLeitor(LeitorRegistros *leitor, const char *caminho) {
+    struct stat info;
+    int descritor = open(caminho, O_RDONLY);
+
+    leitor->dados = NULL;
+    if (descritor < 0) {
+        return false;
+    }
+    if (fstat(descritor, &info) != 0 || info.st_size < ARQUIVO_CABECALHO) {
+        close(descritor);
+        return false;
+    }
+
+    leitor->tamanho_mapa = (size_t)info.st_size;
+    void *mapa = mmap(NULL, leitor->tamanho_mapa, PROT_READ, MAP_PRIVATE, descritor, 0);
+    close(descritor); // O mapeamento continua válido sem o descritor
+    if (mapa == MAP_FAILED) {
+        return false;
+    }
+    posix_madvise(mapa, leitor->tamanho_mapa, POSIX_MADV_SEQUENTIAL);
+    leitor->dados = mapa;
+
+    const uint8_t *cabecalho = leitor->dados;
+    leitor->tipo = (TipoRegistro)cabecalho[6];
+    leitor->navios_por_registro = lerU16(cabecalho + 8);
+    leitor->bytes_registro = lerU16(cabecalho + 10);
+    if (memcmp(cabecalho, ARQUIVO_MAGICO, 4) != 0 || lerU16(cabecalho + 4) != ARQUIVO_VERSAO ||
+        cabecalho[7] != TABULEIRO_TAMANHO || (leitor->tipo != REGISTRO_BITBOARD && leitor->tipo != REGISTRO_NAVIOS) ||
+        (leitor->tipo == REGISTRO_NAVIOS && leitor->navios_por_registro > MAX_NAVIOS_FROTA) ||
+        leitor->bytes_registro == 0 || leitor->bytes_registro != bytesRegistro(leitor->tipo, leitor->navios_por_registro)) {
+        fecharLeitor(leitor);
+        return false;
+    }
+
+    // Registros completos presentes no arquivo; o cabeçalho pode indicar menos
+    uint64_t presentes = (leitor->tamanho_mapa - ARQUIVO_CABECALHO) / leitor->bytes_registro;
+    uint64_t declarados = lerU64(cabecalho + 12);
+    leitor->quantidade = declarados != 0 && declarados < presentes ? declarados : presentes;
+    return true;
+}
+
+// Função para obter os bytes do registro 'indice' direto do mapa (sem cópia)
+static inline const uint8_t *registroLeitor(const LeitorRegistros *leitor, uint64_t indice) {
+    return leitor->dados + ARQUIVO_CABECALHO + indice * leitor->bytes_registro;
+}
+
+// Função para reconstruir o tabuleiro em bitboard do registro 'indice'
+// Funciona para os dois tipos de registro. Retorna false se a lista de navios for inválida.
+bool lerRegistroBits(const LeitorRegistros *leitor, uint64_t indice, TabuleiroBits *tabuleiro) {
+    const uint8_t *registro = registroLeitor(leitor, indice);
+
+    limparTabuleiroBits(tabuleiro);
+    if (leitor->tipo == REGISTRO_BITBOARD) {
+        tabuleiro->navios = lerMascara(registro);
+        tabuleiro->habilidades = lerMascara(registro + BYTES_MASCARA) & ~tabuleiro->navios;
+        tabuleiro->ocupadas |= tabuleiro->navios | tabuleiro->habilidades;
+        return true;
+    }
+
+    for (int i = 0; i < leitor->navios_por_registro; i++) {
+        int linha = registro[2 * i] & 0x0F;
+        int coluna = registro[2 * i] >> 4;
+        OrientacaoNavio orientacao = (OrientacaoNavio)(registro[2 * i + 1] & 0x03);
+        int size = registro[2 * i + 1] >> 2;
+        if (!canPlaceShipBits(tabuleiro, linha, coluna, size, orientacao)) {
+            return false;
+        }
+        placeShipBits(tabuleiro, linha, coluna, size, orientacao);
+    }
+    return true;
+}
+
+// Função para reconstruir o registro 'indice' na matriz de inteiros (para exibirTabuleiro)
+bool lerRegistroMatriz(const LeitorRegistros *leitor, uint64_t indice,
+                       int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]) {
+    TabuleiroBits bits;
+    if (!lerRegistroBits(leitor, indice, &bits)) {
+        return false;
+    }
+    bitboardParaMatriz(&bits, tabuleiro);
+    return true;
+}
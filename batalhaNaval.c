@@ -1,316 +1,2024 @@
+#define _POSIX_C_SOURCE 200809L // Para clock_gettime nas medições de desempenho
+
 #include <stdio.h>   // Biblioteca padrão para entrada e saída de dados
 #include <stdbool.h> // Para usar tipos booleanos (true/false)
-#include <stdlib.h>  // Para usar abs() para o cálculo das formas das habilidades
-
-// --- Constantes para o Tabuleiro de Batalha Naval ---
-#define TABULEIRO_TAMANHO 10 // Tabuleiro 10x10
-#define TAMANHO_NAVIO 3      // Navios de 3 posições
-#define VALOR_AGUA 0         // Representa água no tabuleiro
-#define VALOR_NAVIO 3        // Representa parte de um navio no tabuleiro
-#define VALOR_HABILIDADE 5   // Representa área afetada por habilidade
-
-// --- Constantes para as Matrizes de Habilidade ---
-#define HABILIDADE_TAMANHO 7 // Tamanho das matrizes de habilidade (ex: 7x7)
-#define HABILIDADE_CENTRO (HABILIDADE_TAMANHO / 2) // Centro para cálculos de forma
-
-// Enumeração para tipos de orientação de navio
-// Torna o código mais legível e robusto para definir a orientação dos navios.
-typedef enum {
-    HORIZONTAL,
-    VERTICAL,
-    DIAGONAL_UP_RIGHT,   // Linha diminui, coluna aumenta (ex: (2,0) -> (1,1) -> (0,2))
-    DIAGONAL_DOWN_RIGHT  // Linha aumenta, coluna aumenta (ex: (0,0) -> (1,1) -> (2,2))
-} OrientacaoNavio;
-
-
-// --- Funções Recursivas para Movimento das Peças de Xadrez ---
-// (Estas funções permanecem inalteradas do desafio anterior)
-
-// Função recursiva para simular o movimento da TORRE
-// Move a peça 'direcao_str' por 'passos_restantes' casas.
-// current_step: o número da casa atual na simulação.
-void moverTorreRecursivo(int passos_restantes, int current_step) {
-    // Caso base: Se não há mais passos para mover, a recursão termina.
-    if (passos_restantes == 0) {
-        printf("Torre parou.\n\n");
-        return;
+#include <stdlib.h>  // Para abs(), malloc/free e strtoll
+#include <stdint.h>  // Para tipos inteiros de largura fixa usados nos bitboards
+#include <string.h>  // Para strcmp, memcpy e memset
+#include <time.h>    // Para clock_gettime nas medições de desempenho
+#include <unistd.h>  // Para sysconf (número de núcleos) e close
+
+#include "batalhaNaval.h" // Motor do jogo (biblioteca libbatalhanaval.a)
+
+// --- Movimento das Peças de Xadrez ---
+// Os caminhos vêm do motor de movimento (caminhoPeca), sem recursão; cada peça parte de uma
+// casa do tabuleiro vazio de onde o percurso pedido cabe inteiro.
+
+// Função para exibir o caminho de uma peça, uma linha por casa visitada
+// 'texto_direcao' é o nome da direção impresso em cada casa; 'nome' é o nome da peça.
+void exibirCaminhoPeca(const char *nome, const char *texto_direcao, int linha, int coluna,
+                       DirecaoMovimento direcao, int passos) {
+    uint8_t casas[TABULEIRO_TAMANHO];
+    int visitadas = caminhoPeca(linha * TABULEIRO_TAMANHO + coluna, direcao, passos, 0, casas);
+
+    for (int i = 0; i < visitadas; i++) {
+        printf("Casa %d: %s\n", i + 1, texto_direcao);
     }
+    printf("%s parou.\n\n", nome);
+}
 
-    // Ação: Imprime a direção do movimento para o passo atual.
-    printf("Casa %d: Direita\n", current_step);
+// Função para simular o movimento da TORRE: 'passos' casas para a direita, a partir de (0,0)
+void moverTorre(int passos) {
+    exibirCaminhoPeca("Torre", "Direita", 0, 0, DIRECAO_DIREITA, passos);
+}
 
-    // Chamada recursiva: Decrementa os passos restantes e incrementa o passo atual.
-    moverTorreRecursivo(passos_restantes - 1, current_step + 1);
+// Função para simular o movimento do BISPO: 'passos' casas na diagonal (cima e direita), a partir de (9,0)
+void moverBispo(int passos) {
+    exibirCaminhoPeca("Bispo", "Cima, Direita", TABULEIRO_TAMANHO - 1, 0, DIRECAO_CIMA_DIREITA, passos);
 }
 
-// Função recursiva para simular o movimento do BISPO
-// Move a peça na diagonal por 'passos_restantes' casas.
-// current_step: o número da casa atual na simulação.
-void moverBispoRecursivo(int passos_restantes, int current_step) {
-    // Caso base: Se não há mais passos para mover, a recursão termina.
-    if (passos_restantes == 0) {
-        printf("Bispo parou.\n\n");
+// Função para simular o movimento da RAINHA: 'passos' casas para a esquerda, a partir de (0,9)
+void moverRainha(int passos) {
+    exibirCaminhoPeca("Rainha", "Esquerda", 0, TABULEIRO_TAMANHO - 1, DIRECAO_ESQUERDA, passos);
+}
+
+// Função para simular o salto do CAVALO de (linha, coluna) para (linha + delta_row, coluna + delta_col)
+// O salto é conferido na tabela de saltos do motor; os passos impressos decompõem o "L" em
+// movimentos verticais seguidos dos horizontais.
+void moverCavalo(int linha, int coluna, int delta_row, int delta_col) {
+    int destino_row = linha + delta_row, destino_col = coluna + delta_col;
+    int passo_total = 0; // Contador de passos totais para o Cavalo
+
+    if ((unsigned)destino_row >= TABULEIRO_TAMANHO || (unsigned)destino_col >= TABULEIRO_TAMANHO ||
+        !(movimentosPeca(PECA_CAVALO, linha * TABULEIRO_TAMANHO + coluna, 0) &
+          BITBOARD_CELULA(destino_row, destino_col))) {
+        printf("O Cavalo nao pode saltar para (%d, %d).\n\n", destino_row, destino_col);
         return;
     }
+    for (int y = 0; y < abs(delta_row); y++) {
+        printf("Passo %d do Cavalo: %s\n", ++passo_total, delta_row < 0 ? "Cima" : "Baixo");
+    }
+    for (int x = 0; x < abs(delta_col); x++) {
+        printf("Passo %d do Cavalo: %s\n", ++passo_total, delta_col < 0 ? "Esquerda" : "Direita");
+    }
+    printf("Cavalo parou.\n\n");
+}
 
-    // Ação: Imprime a direção do movimento para o passo atual.
-    printf("Casa %d: Cima, Direita\n", current_step);
+// --- Exibição na Saída Padrão ---
+// O motor apenas renderiza em buffers; as funções abaixo escrevem o resultado na saída padrão.
 
-    // Chamada recursiva: Decrementa os passos restantes e incrementa o passo atual.
-    moverBispoRecursivo(passos_restantes - 1, current_step + 1);
+// Função para exibir o tabuleiro de Batalha Naval com diferentes caracteres
+// Monta o tabuleiro em um buffer na pilha e o escreve com uma única chamada.
+void exibirTabuleiro(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]) {
+    char buffer[RENDERIZACAO_MAX_COMPLETO];
+    size_t tamanho = renderizarTabuleiro(tabuleiro, buffer, FORMATO_COMPLETO);
+    fwrite(buffer, 1, tamanho, stdout);
 }
 
-// Função recursiva para simular o movimento da RAINHA
-// Move a peça 'direcao_str' por 'passos_restantes' casas.
-// current_step: o número da casa atual na simulação.
-void moverRainhaRecursivo(int passos_restantes, int current_step) {
-    // Caso base: Se não há mais passos para mover, a recursão termina.
-    if (passos_restantes == 0) {
-        printf("Rainha parou.\n\n");
-        return;
+// Função para exibir um tabuleiro em bitboard
+// Converte para a matriz de inteiros e reutiliza exibirTabuleiro, garantindo a mesma saída.
+void exibirTabuleiroBits(const TabuleiroBits *bits) {
+    int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+    bitboardParaMatriz(bits, tabuleiro);
+    exibirTabuleiro(tabuleiro);
+}
+
+// Função para exibir uma matriz de habilidade (valores separados por espaço e uma linha em branco)
+// Monta todas as linhas em um buffer e as escreve com uma única chamada.
+void exibirHabilidade(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]) {
+    char buffer[RENDERIZACAO_MAX_HABILIDADE];
+    size_t tamanho = renderizarHabilidade(matriz_habilidade, buffer);
+    fwrite(buffer, 1, tamanho, stdout);
+}
+
+// Variante de exibirTabuleiro para o mapa de calor da camada de intensidade
+void exibirMapaCalor(const CamadaIntensidade *camada) {
+    char buffer[RENDERIZACAO_MAX_COMPLETO];
+    size_t tamanho = renderizarMapaCalor(camada, buffer);
+    fwrite(buffer, 1, tamanho, stdout);
+}
+
+// Função auxiliar para contar os dígitos decimais de um número não negativo
+static int contarDigitos(int valor) {
+    int digitos = 1;
+    while (valor >= 10) {
+        valor /= 10;
+        digitos++;
     }
+    return digitos;
+}
 
-    // Ação: Imprime a direção do movimento para o passo atual.
-    printf("Casa %d: Esquerda\n", current_step);
+// Função auxiliar para imprimir a linha separadora do tabuleiro com 'tracos' traços
+static void exibirSeparadorDinamico(int tracos) {
+    printf("  ");
+    for (int i = 0; i < tracos; i++) {
+        putchar('-');
+    }
+    printf("\n");
+}
 
-    // Chamada recursiva: Decrementa os passos restantes e incrementa o passo atual.
-    moverRainhaRecursivo(passos_restantes - 1, current_step + 1);
+// Função para exibir um Tabuleiro de qualquer dimensão
+// Para 10x10 a saída é idêntica à de exibirTabuleiro; em tabuleiros maiores as colunas
+// são alargadas para caber os números de dois dígitos.
+void exibirTabuleiroDinamico(const Tabuleiro *tabuleiro) {
+    int largura_linha = contarDigitos(tabuleiro->linhas - 1);   // Largura do número da linha
+    int largura_coluna = contarDigitos(tabuleiro->colunas - 1); // Largura de cada célula
+    int tracos = tabuleiro->colunas * (largura_coluna + 1) + 12;
+
+    printf("%*s", largura_linha + 2, ""); // Espaço para o número da linha
+    for (int c = 0; c < tabuleiro->colunas; c++) {
+        printf("%*d ", largura_coluna, c); // Números das colunas
+    }
+    printf("\n");
+    exibirSeparadorDinamico(tracos);
+
+    for (int r = 0; r < tabuleiro->linhas; r++) {
+        printf("%*d |", largura_linha, r); // Número da linha e separador
+        for (int c = 0; c < tabuleiro->colunas; c++) {
+            int valor = TABULEIRO_CELULA(tabuleiro, r, c);
+            if (valor == VALOR_AGUA) {
+                printf("%*s ", largura_coluna, "~");
+            } else if (valor == VALOR_NAVIO) {
+                printf("%*s ", largura_coluna, "N");
+            } else if (valor == VALOR_HABILIDADE) {
+                printf("%*s ", largura_coluna, "A");
+            } else {
+                printf("%*d ", largura_coluna, valor); // Qualquer outro valor inesperado
+            }
+        }
+        printf("|\n");
+    }
+    exibirSeparadorDinamico(tracos);
+    printf("\n");
 }
 
+// --- Modos de Linha de Comando ---
 
-// --- Funções Auxiliares para Batalha Naval ---
+// Função auxiliar para obter o tempo atual em nanossegundos (relógio monotônico)
+static uint64_t tempoNanossegundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
 
-// Função para verificar se um navio pode ser posicionado no tabuleiro
-// Verifica se todas as posições do navio estão dentro dos limites do tabuleiro
-// e se não estão ocupadas por outras partes de navio (valor 3).
-// Retorna true se o posicionamento é válido, false caso contrário.
-bool canPlaceShip(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
-                  int start_row, int start_col, int size, OrientacaoNavio orientation) {
-    int r, c; // Variáveis para as coordenadas atuais dentro do loop
+// Função auxiliar para ler um argumento numérico opcional da linha de comando
+static long long argumentoInteiro(int argc, char *argv[], int indice, long long padrao) {
+    return indice < argc ? strtoll(argv[indice], NULL, 10) : padrao;
+}
 
-    for (int i = 0; i < size; i++) {
-        // Calcula as coordenadas da posição atual do navio com base na orientação
-        if (orientation == HORIZONTAL) {
-            r = start_row;
-            c = start_col + i;
-        } else if (orientation == VERTICAL) {
-            r = start_row + i;
-            c = start_col;
-        } else if (orientation == DIAGONAL_DOWN_RIGHT) { // Linha aumenta, coluna aumenta
-            r = start_row + i;
-            c = start_col + i;
-        } else if (orientation == DIAGONAL_UP_RIGHT) { // Linha diminui, coluna aumenta
-            r = start_row - i;
-            c = start_col + i;
-        } else {
-            // Caso de orientação inválida, embora o enum restrinja isso
+// Função auxiliar para montar a configuração de frota a partir dos argumentos
+// Sem tamanhos informados, usa a frota da demonstração: 4 navios de TAMANHO_NAVIO.
+// Retorna false (com a mensagem de erro já escrita) se um tamanho não for um número de 1 a
+// TABULEIRO_TAMANHO ou se houver mais de MAX_NAVIOS_FROTA navios.
+static bool argumentosConfiguracaoFrota(int argc, char *argv[], int primeiro, ConfiguracaoFrota *config) {
+    config->quantidade_navios = 0;
+    for (int i = primeiro; i < argc; i++) {
+        char *fim;
+        long tamanho = strtol(argv[i], &fim, 10);
+
+        if (fim == argv[i] || *fim != '\0' || tamanho < 1 || tamanho > TABULEIRO_TAMANHO) {
+            fprintf(stderr, "Erro: tamanho de navio invalido: %s (use 1 a %d).\n", argv[i], TABULEIRO_TAMANHO);
             return false;
         }
+        if (config->quantidade_navios == MAX_NAVIOS_FROTA) {
+            fprintf(stderr, "Erro: no maximo %d navios por frota.\n", MAX_NAVIOS_FROTA);
+            return false;
+        }
+        config->tamanhos[config->quantidade_navios++] = (uint8_t)tamanho;
+    }
+    if (config->quantidade_navios == 0) {
+        config->quantidade_navios = 4;
+        for (int i = 0; i < 4; i++) {
+            config->tamanhos[i] = TAMANHO_NAVIO;
+        }
+    }
+    return true;
+}
+
+// Modo "frotas": gera e exibe frotas aleatórias
+// Uso: frotas [quantidade] [semente] [tamanhos...]
+static int modoFrotas(int argc, char *argv[]) {
+    int quantidade = (int)argumentoInteiro(argc, argv, 2, 1);
+    uint64_t semente = (uint64_t)argumentoInteiro(argc, argv, 3, 1);
+    ConfiguracaoFrota config;
+    GeradorAleatorio gerador;
 
-        // --- Validação de Limites ---
-        // Verifica se a posição calculada está dentro dos limites do tabuleiro (0 a TABULEIRO_TAMANHO-1)
-        if (r < 0 || r >= TABULEIRO_TAMANHO || c < 0 || c >= TABULEIRO_TAMANHO) {
-            return false; // Fora dos limites do tabuleiro
+    if (!argumentosConfiguracaoFrota(argc, argv, 4, &config)) {
+        return 1;
+    }
+    if (!configuracaoFrotaValida(&config)) {
+        fprintf(stderr, "Erro: configuracao de frota invalida.\n");
+        return 1;
+    }
+    semearGerador(&gerador, semente);
+
+    for (int i = 0; i < quantidade; i++) {
+        Frota frota;
+        int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO] = {{VALOR_AGUA}};
+
+        if (!gerarFrota(&gerador, &config, &frota) || !posicionarFrota(tabuleiro, &frota, &config)) {
+            fprintf(stderr, "Erro: nao foi possivel posicionar a frota %d.\n", i + 1);
+            return 1;
         }
+        printf("--- Frota %d ---\n", i + 1);
+        exibirTabuleiro(tabuleiro);
+    }
+    return 0;
+}
 
-        // --- Validação de Sobreposição ---
-        // Verifica se a posição já está ocupada por outro navio (valor 3)
-        if (tabuleiro[r][c] != VALOR_AGUA) { // Se não for água, já está ocupado
-            return false; // Sobreposição detectada
+// Modo "bench-frotas": mede a vazão do gerador de frotas em lotes
+// Uso: bench-frotas [quantidade] [semente] [tamanhos...]
+#define LOTE_FROTAS 4096
+static int modoBenchFrotas(int argc, char *argv[]) {
+    long long quantidade = argumentoInteiro(argc, argv, 2, 1000000);
+    uint64_t semente = (uint64_t)argumentoInteiro(argc, argv, 3, 1);
+    static Frota lote[LOTE_FROTAS];
+    ConfiguracaoFrota config;
+    GeradorAleatorio gerador;
+    uint64_t verificacao = 0; // Impede que o compilador descarte o trabalho
+    long long geradas = 0;
+
+    if (quantidade <= 0) {
+        fprintf(stderr, "Erro: a quantidade de frotas deve ser positiva.\n");
+        return 1;
+    }
+    if (!argumentosConfiguracaoFrota(argc, argv, 4, &config)) {
+        return 1;
+    }
+    if (!configuracaoFrotaValida(&config)) {
+        fprintf(stderr, "Erro: configuracao de frota invalida.\n");
+        return 1;
+    }
+    semearGerador(&gerador, semente);
+
+    uint64_t inicio = tempoNanossegundos();
+    while (geradas < quantidade) {
+        int pedidas = (int)(quantidade - geradas < LOTE_FROTAS ? quantidade - geradas : LOTE_FROTAS);
+        int n = gerarFrotas(&gerador, &config, lote, pedidas);
+        for (int i = 0; i < n; i++) {
+            verificacao += (uint64_t)lote[i].navios ^ (uint64_t)(lote[i].navios >> 64);
+        }
+        geradas += n;
+        if (n < pedidas) {
+            fprintf(stderr, "Erro: configuracao impossivel de posicionar.\n");
+            return 1;
         }
     }
-    return true; // Se todas as verificações passarem, o posicionamento é válido
+    double segundos = (double)(tempoNanossegundos() - inicio) / 1e9;
+
+    printf("Frotas geradas: %lld (%d navios)\n", geradas, config.quantidade_navios);
+    printf("Tempo: %.3f s\n", segundos);
+    printf("Frotas/segundo: %.0f\n", (double)geradas / segundos);
+    printf("ns/frota: %.1f\n", segundos * 1e9 / (double)geradas);
+    printf("Verificacao: %016llx\n", (unsigned long long)verificacao);
+    return 0;
 }
 
-// Função para posicionar um navio no tabuleiro
-// Esta função assume que 'canPlaceShip' já foi chamada e confirmou que o posicionamento é válido.
-// Ela simplesmente marca as posições no tabuleiro com o valor '3' (parte do navio).
-void placeShip(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
-               int start_row, int start_col, int size, OrientacaoNavio orientation) {
-    int r, c; // Variáveis para as coordenadas atuais dentro do loop
+// Modo "bench-tabuleiro": compara o tabuleiro dinâmico com a matriz fixa int[10][10]
+// Cada rodada limpa o tabuleiro e tenta posicionar navios em coordenadas sorteadas;
+// o tempo é reportado por tentativa (canPlaceShip + placeShip quando válido).
+// Uso: bench-tabuleiro [rodadas] [semente]
+#define BENCH_TENTATIVAS 4096 // Tentativas sorteadas, reutilizadas em todas as rodadas
+#define BENCH_NAVIOS_RODADA 16 // Tentativas de posicionamento por rodada
+
+typedef struct {
+    uint8_t linha;
+    uint8_t coluna;
+    uint8_t tamanho;
+    uint8_t orientacao;
+} TentativaBench;
+
+// Função auxiliar para sortear as tentativas de posicionamento de um tabuleiro linhas x colunas
+static void sortearTentativas(GeradorAleatorio *gerador, TentativaBench tentativas[], int linhas, int colunas) {
+    for (int i = 0; i < BENCH_TENTATIVAS; i++) {
+        tentativas[i].linha = (uint8_t)aleatorioAte(gerador, (uint32_t)linhas);
+        tentativas[i].coluna = (uint8_t)aleatorioAte(gerador, (uint32_t)colunas);
+        tentativas[i].tamanho = (uint8_t)(2 + aleatorioAte(gerador, 4)); // Navios de 2 a 5 posições
+        tentativas[i].orientacao = (uint8_t)aleatorioAte(gerador, NUM_ORIENTACOES);
+    }
+}
 
-    for (int i = 0; i < size; i++) {
-        // Calcula as coordenadas da posição atual do navio com base na orientação
-        if (orientation == HORIZONTAL) {
-            r = start_row;
-            c = start_col + i;
-        } else if (orientation == VERTICAL) {
-            r = start_row + i;
-            c = start_col;
-        } else if (orientation == DIAGONAL_DOWN_RIGHT) {
-            r = start_row + i;
-            c = start_col + i;
-        } else if (orientation == DIAGONAL_UP_RIGHT) {
-            r = start_row - i;
-            c = start_col + i;
+// Função auxiliar que mede o tabuleiro dinâmico e imprime ns/tentativa
+static void benchTabuleiroDinamico(const char *nome, Tabuleiro *tabuleiro,
+                                   const TentativaBench tentativas[], long long rodadas) {
+    long long posicionados = 0;
+    int t = 0;
+    uint64_t inicio = tempoNanossegundos();
+
+    for (long long rodada = 0; rodada < rodadas; rodada++) {
+        limparTabuleiro(tabuleiro);
+        for (int k = 0; k < BENCH_NAVIOS_RODADA; k++, t = (t + 1) % BENCH_TENTATIVAS) {
+            const TentativaBench *p = &tentativas[t];
+            if (canPlaceShipTabuleiro(tabuleiro, p->linha, p->coluna, p->tamanho, (OrientacaoNavio)p->orientacao)) {
+                placeShipTabuleiro(tabuleiro, p->linha, p->coluna, p->tamanho, (OrientacaoNavio)p->orientacao);
+                posicionados++;
+            }
         }
-        tabuleiro[r][c] = VALOR_NAVIO; // Marca a posição como parte do navio
     }
+    double ns = (double)(tempoNanossegundos() - inicio) / (double)(rodadas * BENCH_NAVIOS_RODADA);
+    printf("%-28s %8.2f ns/tentativa  (%lld posicionados)\n", nome, ns, posicionados);
 }
 
-// Função para exibir o tabuleiro de Batalha Naval com diferentes caracteres
-void exibirTabuleiro(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]) {
-    int r_tab, c_tab; // Variáveis de controle para loops do tabuleiro
+static int modoBenchTabuleiro(int argc, char *argv[]) {
+    long long rodadas = argumentoInteiro(argc, argv, 2, 2000000);
+    uint64_t semente = (uint64_t)argumentoInteiro(argc, argv, 3, 1);
+    static TentativaBench tentativas[BENCH_TENTATIVAS];
+    GeradorAleatorio gerador;
+    Tabuleiro dinamico;
 
-    // Imprime cabeçalho de colunas para melhor visualização
-    printf("   "); // Espaço para o número da linha
-    for (c_tab = 0; c_tab < TABULEIRO_TAMANHO; c_tab++) {
-        printf("%d ", c_tab); // Números das colunas
+    if (rodadas <= 0) {
+        fprintf(stderr, "Erro: a quantidade de rodadas deve ser positiva.\n");
+        return 1;
     }
-    printf("\n");
-    printf("  --------------------------------\n"); // Separador visual
-
-    for (r_tab = 0; r_tab < TABULEIRO_TAMANHO; r_tab++) {
-        printf("%d |", r_tab); // Imprime o número da linha e um separador
-        for (c_tab = 0; c_tab < TABULEIRO_TAMANHO; c_tab++) {
-            // Usa caracteres diferentes para representar água, navio e área de habilidade
-            if (tabuleiro[r_tab][c_tab] == VALOR_AGUA) {
-                printf("~ "); // Água
-            } else if (tabuleiro[r_tab][c_tab] == VALOR_NAVIO) {
-                printf("N "); // Navio
-            } else if (tabuleiro[r_tab][c_tab] == VALOR_HABILIDADE) {
-                printf("A "); // Área de Habilidade
+    semearGerador(&gerador, semente);
+    sortearTentativas(&gerador, tentativas, 10, 10);
+
+    // Referência: a matriz fixa int[10][10] com as funções originais
+    int fixo[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+    long long posicionados = 0;
+    int t = 0;
+    uint64_t inicio = tempoNanossegundos();
+    for (long long rodada = 0; rodada < rodadas; rodada++) {
+        for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+            for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+                fixo[r][c] = VALOR_AGUA;
+            }
+        }
+        for (int k = 0; k < BENCH_NAVIOS_RODADA; k++, t = (t + 1) % BENCH_TENTATIVAS) {
+            const TentativaBench *p = &tentativas[t];
+            if (canPlaceShip(fixo, p->linha, p->coluna, p->tamanho, (OrientacaoNavio)p->orientacao)) {
+                placeShip(fixo, p->linha, p->coluna, p->tamanho, (OrientacaoNavio)p->orientacao);
+                posicionados++;
+            }
+        }
+    }
+    double ns = (double)(tempoNanossegundos() - inicio) / (double)(rodadas * BENCH_NAVIOS_RODADA);
+    printf("%-28s %8.2f ns/tentativa  (%lld posicionados)\n", "int[10][10] (original)", ns, posicionados);
+
+    // Tabuleiro dinâmico 10x10: caminho especializado e caminho genérico forçado
+    if (!criarTabuleiro(&dinamico, 10, 10)) {
+        fprintf(stderr, "Erro: nao foi possivel alocar o tabuleiro.\n");
+        return 1;
+    }
+    benchTabuleiroDinamico("Tabuleiro 10x10 (especial)", &dinamico, tentativas, rodadas);
+    dinamico.forma = FORMA_GENERICA;
+    benchTabuleiroDinamico("Tabuleiro 10x10 (generico)", &dinamico, tentativas, rodadas);
+    liberarTabuleiro(&dinamico);
+
+    // Tamanhos maiores: 16x16 especializado e genérico, 64x64 genérico
+    sortearTentativas(&gerador, tentativas, 16, 16);
+    if (!criarTabuleiro(&dinamico, 16, 16)) {
+        fprintf(stderr, "Erro: nao foi possivel alocar o tabuleiro.\n");
+        return 1;
+    }
+    benchTabuleiroDinamico("Tabuleiro 16x16 (especial)", &dinamico, tentativas, rodadas);
+    dinamico.forma = FORMA_GENERICA;
+    benchTabuleiroDinamico("Tabuleiro 16x16 (generico)", &dinamico, tentativas, rodadas);
+    liberarTabuleiro(&dinamico);
+
+    sortearTentativas(&gerador, tentativas, 64, 64);
+    if (!criarTabuleiro(&dinamico, 64, 64)) {
+        fprintf(stderr, "Erro: nao foi possivel alocar o tabuleiro.\n");
+        return 1;
+    }
+    benchTabuleiroDinamico("Tabuleiro 64x64 (generico)", &dinamico, tentativas, MAXIMO(rodadas / 16, 1));
+    liberarTabuleiro(&dinamico);
+    return 0;
+}
+
+// Modo "bench-solver": partidas completas do solver contra frotas aleatórias
+// Uso: bench-solver [partidas] [semente] [tamanhos...]
+static int modoBenchSolver(int argc, char *argv[]) {
+    long long partidas = argumentoInteiro(argc, argv, 2, 100000);
+    uint64_t semente = (uint64_t)argumentoInteiro(argc, argv, 3, 1);
+    ConfiguracaoFrota config;
+    GeradorAleatorio gerador;
+    static SolverTiros solver;
+    long long total_tiros = 0;
+    int minimo = TABULEIRO_CELULAS, maximo = 0;
+
+    if (partidas < 1) {
+        fprintf(stderr, "Erro: a quantidade de partidas deve ser positiva.\n");
+        return 1;
+    }
+    if (!argumentosConfiguracaoFrota(argc, argv, 4, &config)) {
+        return 1;
+    }
+    if (!configuracaoFrotaValida(&config)) {
+        fprintf(stderr, "Erro: configuracao de frota invalida.\n");
+        return 1;
+    }
+    semearGerador(&gerador, semente);
+
+    uint64_t inicio = tempoNanossegundos();
+    for (long long i = 0; i < partidas; i++) {
+        Frota frota;
+        if (!gerarFrota(&gerador, &config, &frota)) {
+            fprintf(stderr, "Erro: configuracao impossivel de posicionar.\n");
+            return 1;
+        }
+        int tiros = jogarPartidaSolver(&solver, &frota, &config);
+        total_tiros += tiros;
+        minimo = MINIMO(minimo, tiros);
+        maximo = MAXIMO(maximo, tiros);
+    }
+    double segundos = (double)(tempoNanossegundos() - inicio) / 1e9;
+
+    printf("Partidas: %lld (%d navios)\n", partidas, config.quantidade_navios);
+    printf("Tiros para vencer: media %.2f, minimo %d, maximo %d\n",
+           (double)total_tiros / (double)partidas, minimo, maximo);
+    printf("Partidas/segundo: %.0f\n", (double)partidas / segundos);
+    printf("us/partida: %.2f\n", segundos * 1e6 / (double)partidas);
+    return 0;
+}
+
+// Implementação de referência de exibirTabuleiro (um fprintf por célula), para o benchmark
+// do renderizador e para o modo "verificar"
+static void exibirTabuleiroReferencia(FILE *saida, int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]) {
+    fprintf(saida, "   ");
+    for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+        fprintf(saida, "%d ", c);
+    }
+    fprintf(saida, "\n");
+    fprintf(saida, "  --------------------------------\n");
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        fprintf(saida, "%d |", r);
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            if (tabuleiro[r][c] == VALOR_AGUA) {
+                fprintf(saida, "~ ");
+            } else if (tabuleiro[r][c] == VALOR_NAVIO) {
+                fprintf(saida, "N ");
+            } else if (tabuleiro[r][c] == VALOR_HABILIDADE) {
+                fprintf(saida, "A ");
             } else {
-                printf("%d ", tabuleiro[r_tab][c_tab]); // Qualquer outro valor inesperado
+                fprintf(saida, "%d ", tabuleiro[r][c]);
             }
         }
-        printf("|\n"); // Quebra de linha no final de cada linha do tabuleiro
+        fprintf(saida, "|\n");
     }
-    printf("  --------------------------------\n"); // Separador final
-    printf("\n");
+    fprintf(saida, "  --------------------------------\n");
+    fprintf(saida, "\n");
 }
 
-// Função para criar a matriz de habilidade em forma de CONE (apontando para baixo)
-void criarHabilidadeCone(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]) {
-    int r, c;
-    for (r = 0; r < HABILIDADE_TAMANHO; r++) {
-        for (c = 0; c < HABILIDADE_TAMANHO; c++) {
-            // Lógica para formar um cone apontando para baixo
-            // O centro da base do cone está no meio da última linha (HABILIDADE_CENTRO)
-            // A largura do cone aumenta com a linha 'r'
-            // abs(c - HABILIDADE_CENTRO) calcula a distância horizontal do centro
-            if (abs(c - HABILIDADE_CENTRO) <= r) {
-                matriz_habilidade[r][c] = 1;
+// Modo "bench-desfazer": compara as duas formas de voltar ao tabuleiro só com navios
+// entre avaliações de habilidade: re-inicializar as 100 células e re-posicionar a frota,
+// ou retornar ao instantâneo pelo registro de desfazer.
+// Uso: bench-desfazer [avaliacoes] [semente]
+#define LOTE_DESFAZER 1024
+static int modoBenchDesfazer(int argc, char *argv[]) {
+    long long quantidade = argumentoInteiro(argc, argv, 2, 2000000);
+    uint64_t semente = (uint64_t)argumentoInteiro(argc, argv, 3, 1);
+    static const MascaraHabilidade formas[] = {MASCARA_CONE, MASCARA_CRUZ, MASCARA_OCTAEDRO};
+    static uint8_t origens[LOTE_DESFAZER][2];
+    ConfiguracaoFrota config = {4, {TAMANHO_NAVIO, TAMANHO_NAVIO, TAMANHO_NAVIO, TAMANHO_NAVIO}};
+    GeradorAleatorio gerador;
+    Frota frota;
+    uint64_t soma_copia = 0, soma_desfazer = 0;
+
+    if (quantidade < 1) {
+        fprintf(stderr, "Erro: a quantidade de avaliacoes deve ser positiva.\n");
+        return 1;
+    }
+    semearGerador(&gerador, semente);
+    if (!gerarFrota(&gerador, &config, &frota)) {
+        fprintf(stderr, "Erro: configuracao de frota invalida.\n");
+        return 1;
+    }
+    for (int i = 0; i < LOTE_DESFAZER; i++) {
+        origens[i][0] = (uint8_t)aleatorioAte(&gerador, TABULEIRO_TAMANHO);
+        origens[i][1] = (uint8_t)aleatorioAte(&gerador, TABULEIRO_TAMANHO);
+    }
+
+    // Re-inicialização completa + re-posicionamento dos navios a cada avaliação
+    int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+    uint64_t inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade; i++) {
+        const uint8_t *origem = origens[i % LOTE_DESFAZER];
+        for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+            for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+                tabuleiro[r][c] = VALOR_AGUA;
+            }
+        }
+        posicionarFrota(tabuleiro, &frota, &config);
+        aplicarMascaraHabilidade(tabuleiro, formas[i % 3], origem[0], origem[1]);
+        soma_copia += (uint64_t)tabuleiro[origem[0]][origem[1]];
+    }
+    double ns_copia = (double)(tempoNanossegundos() - inicio) / (double)quantidade;
+
+    // Retorno ao instantâneo: só as células alteradas pela habilidade são restauradas
+    static TabuleiroDesfazer desfazer;
+    iniciarTabuleiroDesfazer(&desfazer);
+    for (int i = 0; i < config.quantidade_navios; i++) {
+        const PosicionamentoNavio *p = posicionamentoPorIndice(frota.posicionamento[i]);
+        placeShipDesfazer(&desfazer, p->linha, p->coluna, p->tamanho, (OrientacaoNavio)p->orientacao);
+    }
+    PontoRestauracao navios = pontoRestauracao(&desfazer);
+    inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade; i++) {
+        const uint8_t *origem = origens[i % LOTE_DESFAZER];
+        restaurarTabuleiro(&desfazer, navios);
+        aplicarMascaraHabilidadeDesfazer(&desfazer, formas[i % 3], origem[0], origem[1]);
+        soma_desfazer += (uint64_t)desfazer.celulas[origem[0]][origem[1]];
+    }
+    double ns_desfazer = (double)(tempoNanossegundos() - inicio) / (double)quantidade;
+
+    printf("Avaliacoes: %lld (somas de controle %s)\n", quantidade, soma_copia == soma_desfazer ? "iguais" : "DIFERENTES");
+    printf("Re-inicializar + re-posicionar: %8.1f ns/avaliacao\n", ns_copia);
+    printf("Registro de desfazer:           %8.1f ns/avaliacao (%.2fx)\n", ns_desfazer, ns_copia / ns_desfazer);
+    return soma_copia == soma_desfazer ? 0 : 1;
+}
+
+// Modo "bench-origens": avaliação de uma habilidade nas 100 origens de uma vez (carimbos em
+// bitboard) contra uma cópia do tabuleiro por origem com aplicação e varredura
+// Uso: bench-origens [avaliacoes] [semente]
+#define LOTE_ORIGENS 64
+static int modoBenchOrigens(int argc, char *argv[]) {
+    long long quantidade = argumentoInteiro(argc, argv, 2, 20000);
+    uint64_t semente = (uint64_t)argumentoInteiro(argc, argv, 3, 1);
+    static int tabuleiros[LOTE_ORIGENS][TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+    ConfiguracaoFrota config = {4, {TAMANHO_NAVIO, TAMANHO_NAVIO, TAMANHO_NAVIO, TAMANHO_NAVIO}};
+    int matriz[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO];
+    TabelaCarimbos tabela;
+    AvaliacaoOrigens avaliacao;
+    GeradorAleatorio gerador;
+    uint64_t soma_referencia = 0, soma_lote = 0, soma_tabela = 0;
+
+    if (quantidade < 1) {
+        fprintf(stderr, "Erro: a quantidade de avaliacoes deve ser positiva.\n");
+        return 1;
+    }
+    semearGerador(&gerador, semente);
+    for (int i = 0; i < LOTE_ORIGENS; i++) {
+        Frota frota;
+        memset(tabuleiros[i], 0, sizeof(tabuleiros[i]));
+        if (!gerarFrota(&gerador, &config, &frota)) {
+            fprintf(stderr, "Erro: configuracao de frota invalida.\n");
+            return 1;
+        }
+        posicionarFrota(tabuleiros[i], &frota, &config);
+    }
+    criarHabilidadeOctaedro(matriz);
+
+    uint64_t inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade; i++) {
+        avaliarOrigensReferencia(tabuleiros[i % LOTE_ORIGENS], matriz, &avaliacao);
+        soma_referencia += avaliacao.navios[i % TABULEIRO_CELULAS] + avaliacao.agua[i % TABULEIRO_CELULAS];
+    }
+    double ns_referencia = (double)(tempoNanossegundos() - inicio) / (double)quantidade;
+
+    // A tabela de carimbos é preparada a cada avaliação, para incluir o seu custo
+    inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade; i++) {
+        prepararCarimbos(&tabela, compactarHabilidade(matriz));
+        avaliarOrigensHabilidade(tabuleiros[i % LOTE_ORIGENS], &tabela, &avaliacao);
+        soma_lote += avaliacao.navios[i % TABULEIRO_CELULAS] + avaliacao.agua[i % TABULEIRO_CELULAS];
+    }
+    double ns_lote = (double)(tempoNanossegundos() - inicio) / (double)quantidade;
+
+    // Com a tabela reaproveitada entre tabuleiros (mesma forma avaliada várias vezes)
+    inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade; i++) {
+        avaliarOrigensHabilidade(tabuleiros[i % LOTE_ORIGENS], &tabela, &avaliacao);
+        soma_tabela += avaliacao.navios[i % TABULEIRO_CELULAS] + avaliacao.agua[i % TABULEIRO_CELULAS];
+    }
+    double ns_tabela = (double)(tempoNanossegundos() - inicio) / (double)quantidade;
+    bool iguais = soma_referencia == soma_lote && soma_lote == soma_tabela;
+
+    printf("Avaliacoes (100 origens cada): %lld (somas de controle %s)\n", quantidade,
+           iguais ? "iguais" : "DIFERENTES");
+    printf("Copia + aplicacao + varredura:  %10.1f ns/avaliacao\n", ns_referencia);
+    printf("Carimbos (preparando a tabela): %10.1f ns/avaliacao (%.1fx)\n", ns_lote, ns_referencia / ns_lote);
+    printf("Carimbos (tabela pronta):       %10.1f ns/avaliacao (%.1fx)\n", ns_tabela, ns_referencia / ns_tabela);
+    return iguais ? 0 : 1;
+}
+
+// Modo "bench-render": compara a exibição com um fprintf por célula e o renderizador em buffer
+// Todas as saídas vão para /dev/null, para medir só a formatação e as chamadas de stdio.
+// Uso: bench-render [tabuleiros] [semente]
+#define LOTE_RENDERIZACAO 64 // Tabuleiros por escrita no modo em lote
+static int modoBenchRender(int argc, char *argv[]) {
+    long long quantidade = argumentoInteiro(argc, argv, 2, 200000);
+    uint64_t semente = (uint64_t)argumentoInteiro(argc, argv, 3, 1);
+    static int tabuleiros[LOTE_RENDERIZACAO][TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+    static char buffer[LOTE_RENDERIZACAO * RENDERIZACAO_MAX_COMPLETO];
+    ConfiguracaoFrota config = {4, {TAMANHO_NAVIO, TAMANHO_NAVIO, TAMANHO_NAVIO, TAMANHO_NAVIO}};
+    GeradorAleatorio gerador;
+    FILE *nulo;
+
+    if (quantidade < 1) {
+        fprintf(stderr, "Erro: a quantidade de tabuleiros deve ser positiva.\n");
+        return 1;
+    }
+    // Os lotes renderizam sempre LOTE_RENDERIZACAO tabuleiros: a quantidade é arredondada para
+    // cima, para que todas as versões renderizem o mesmo número de tabuleiros
+    quantidade = (quantidade + LOTE_RENDERIZACAO - 1) / LOTE_RENDERIZACAO * LOTE_RENDERIZACAO;
+    nulo = fopen("/dev/null", "w");
+    if (nulo == NULL) {
+        fprintf(stderr, "Erro: nao foi possivel abrir /dev/null.\n");
+        return 1;
+    }
+
+    // Tabuleiros de exemplo: frotas aleatórias com uma habilidade aplicada
+    semearGerador(&gerador, semente);
+    for (int i = 0; i < LOTE_RENDERIZACAO; i++) {
+        Frota frota;
+        memset(tabuleiros[i], 0, sizeof(tabuleiros[i]));
+        if (!gerarFrota(&gerador, &config, &frota)) {
+            fprintf(stderr, "Erro: configuracao de frota invalida.\n");
+            fclose(nulo);
+            return 1;
+        }
+        posicionarFrota(tabuleiros[i], &frota, &config);
+        aplicarMascaraHabilidade(tabuleiros[i], MASCARA_OCTAEDRO, (int)aleatorioAte(&gerador, TABULEIRO_TAMANHO),
+                                 (int)aleatorioAte(&gerador, TABULEIRO_TAMANHO));
+    }
+
+    uint64_t inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade; i++) {
+        exibirTabuleiroReferencia(nulo, tabuleiros[i % LOTE_RENDERIZACAO]);
+    }
+    fflush(nulo);
+    double ns_printf = (double)(tempoNanossegundos() - inicio) / (double)quantidade;
+
+    inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade; i++) {
+        size_t tamanho = renderizarTabuleiro(tabuleiros[i % LOTE_RENDERIZACAO], buffer, FORMATO_COMPLETO);
+        fwrite(buffer, 1, tamanho, nulo);
+    }
+    fflush(nulo);
+    double ns_buffer = (double)(tempoNanossegundos() - inicio) / (double)quantidade;
+
+    inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade; i += LOTE_RENDERIZACAO) {
+        size_t tamanho = renderizarTabuleiros(tabuleiros, LOTE_RENDERIZACAO, buffer, FORMATO_COMPLETO);
+        fwrite(buffer, 1, tamanho, nulo);
+    }
+    fflush(nulo);
+    double ns_lote = (double)(tempoNanossegundos() - inicio) / (double)quantidade;
+
+    inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade; i += LOTE_RENDERIZACAO) {
+        size_t tamanho = renderizarTabuleiros(tabuleiros, LOTE_RENDERIZACAO, buffer, FORMATO_COMPACTO);
+        fwrite(buffer, 1, tamanho, nulo);
+    }
+    fflush(nulo);
+    double ns_compacto = (double)(tempoNanossegundos() - inicio) / (double)quantidade;
+    fclose(nulo);
+
+    printf("Tabuleiros por versao: %lld\n", quantidade);
+    printf("%-32s %8.1f ns/tabuleiro\n", "fprintf por celula (original)", ns_printf);
+    printf("%-32s %8.1f ns/tabuleiro\n", "buffer + 1 fwrite", ns_buffer);
+    printf("%-32s %8.1f ns/tabuleiro\n", "lote de 64 + 1 fwrite", ns_lote);
+    printf("%-32s %8.1f ns/tabuleiro\n", "lote compacto + 1 fwrite", ns_compacto);
+    return 0;
+}
+
+// Movimentos de referência: passo a passo em cada direção da peça, parando na borda ou em um bloqueio
+static Bitboard movimentosPecaReferencia(TipoPeca peca, int celula, Bitboard bloqueios) {
+    static const int8_t saltos[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+    int row = celula / TABULEIRO_TAMANHO, col = celula % TABULEIRO_TAMANHO;
+    Bitboard casas = 0;
+
+    if (peca == PECA_CAVALO) {
+        for (int s = 0; s < 8; s++) {
+            int r = row + saltos[s][0], c = col + saltos[s][1];
+            if (r >= 0 && r < TABULEIRO_TAMANHO && c >= 0 && c < TABULEIRO_TAMANHO &&
+                !(bloqueios & BITBOARD_CELULA(r, c))) {
+                casas |= BITBOARD_CELULA(r, c);
+            }
+        }
+        return casas;
+    }
+    for (int direcao = 0; direcao < NUM_DIRECOES; direcao++) {
+        int delta_row, delta_col;
+        deslocamentoDirecao((DirecaoMovimento)direcao, &delta_row, &delta_col);
+        bool diagonal = delta_row != 0 && delta_col != 0;
+        if ((peca == PECA_TORRE && diagonal) || (peca == PECA_BISPO && !diagonal)) {
+            continue;
+        }
+        for (int r = row + delta_row, c = col + delta_col;
+             r >= 0 && r < TABULEIRO_TAMANHO && c >= 0 && c < TABULEIRO_TAMANHO && !(bloqueios & BITBOARD_CELULA(r, c));
+             r += delta_row, c += delta_col) {
+            casas |= BITBOARD_CELULA(r, c);
+        }
+    }
+    return casas;
+}
+
+// Bloqueios sorteados para a verificação e o benchmark do motor de movimento: os navios de uma
+// frota aleatória de 'navios' navios de tamanho 3 (0 a 4)
+static Bitboard sortearBloqueios(GeradorAleatorio *gerador, int navios) {
+    ConfiguracaoFrota config = {navios, {TAMANHO_NAVIO, TAMANHO_NAVIO, TAMANHO_NAVIO, TAMANHO_NAVIO}};
+    Frota frota;
+
+    if (navios == 0 || !gerarFrota(gerador, &config, &frota)) {
+        return 0;
+    }
+    return frota.navios;
+}
+
+// Modo "bench-movimentos": casas geradas por segundo pelo motor de movimento (raios e tabela de
+// saltos) e pela referência passo a passo, com os navios de frotas aleatórias como bloqueios
+// Uso: bench-movimentos [rodadas] [semente]
+#define LOTE_MOVIMENTOS 256
+static int modoBenchMovimentos(int argc, char *argv[]) {
+    static const char *nomes[NUM_PECAS] = {"Torre", "Bispo", "Rainha", "Cavalo"};
+    long long rodadas = argumentoInteiro(argc, argv, 2, 200);
+    uint64_t semente = (uint64_t)argumentoInteiro(argc, argv, 3, 1);
+    static Bitboard bloqueios[LOTE_MOVIMENTOS];
+    GeradorAleatorio gerador;
+    bool iguais = true;
+
+    if (rodadas <= 0) {
+        fprintf(stderr, "Erro: a quantidade de rodadas deve ser positiva.\n");
+        return 1;
+    }
+    semearGerador(&gerador, semente);
+    for (int i = 0; i < LOTE_MOVIMENTOS; i++) {
+        bloqueios[i] = sortearBloqueios(&gerador, 4);
+    }
+
+    // Cada rodada gera os lances de uma peça em todas as casas de todos os tabuleiros do lote
+    printf("Lances por rodada: %d tabuleiros x %d casas\n", LOTE_MOVIMENTOS, TABULEIRO_CELULAS);
+    for (int peca = 0; peca < NUM_PECAS; peca++) {
+        uint64_t casas_referencia = 0, casas_motor = 0;
+
+        uint64_t inicio = tempoNanossegundos();
+        for (long long r = 0; r < rodadas; r++) {
+            for (int i = 0; i < LOTE_MOVIMENTOS; i++) {
+                for (int celula = 0; celula < TABULEIRO_CELULAS; celula++) {
+                    casas_referencia += contarBits(movimentosPecaReferencia((TipoPeca)peca, celula, bloqueios[i]));
+                }
+            }
+        }
+        double s_referencia = (double)(tempoNanossegundos() - inicio) / 1e9;
+
+        inicio = tempoNanossegundos();
+        for (long long r = 0; r < rodadas; r++) {
+            for (int i = 0; i < LOTE_MOVIMENTOS; i++) {
+                for (int celula = 0; celula < TABULEIRO_CELULAS; celula++) {
+                    casas_motor += contarBits(movimentosPeca((TipoPeca)peca, celula, bloqueios[i]));
+                }
+            }
+        }
+        double s_motor = (double)(tempoNanossegundos() - inicio) / 1e9;
+        double lances = (double)rodadas * LOTE_MOVIMENTOS * TABULEIRO_CELULAS;
+
+        iguais = iguais && casas_referencia == casas_motor;
+        printf("%-7s referencia %7.1f M casas/s (%5.1f ns/lance)  motor %7.1f M casas/s (%5.1f ns/lance, %.1fx)\n",
+               nomes[peca], (double)casas_referencia / s_referencia / 1e6, s_referencia * 1e9 / lances,
+               (double)casas_motor / s_motor / 1e6, s_motor * 1e9 / lances, s_referencia / s_motor);
+    }
+    printf("Somas de controle: %s\n", iguais ? "iguais" : "DIFERENTES");
+    return iguais ? 0 : 1;
+}
+
+// Modo "gravar": grava frotas aleatórias em um arquivo binário
+// Uso: gravar <arquivo> <bits|navios> [frotas] [semente] [tamanhos...]
+static int modoGravar(int argc, char *argv[]) {
+    if (argc < 4 || (strcmp(argv[3], "bits") != 0 && strcmp(argv[3], "navios") != 0)) {
+        fprintf(stderr, "Uso: gravar <arquivo> <bits|navios> [frotas] [semente] [tamanhos...]\n");
+        return 1;
+    }
+    TipoRegistro tipo = strcmp(argv[3], "bits") == 0 ? REGISTRO_BITBOARD : REGISTRO_NAVIOS;
+    long long quantidade = argumentoInteiro(argc, argv, 4, 1000000);
+    uint64_t semente = (uint64_t)argumentoInteiro(argc, argv, 5, 1);
+    ConfiguracaoFrota config;
+    GeradorAleatorio gerador;
+    EscritorRegistros escritor;
+    bool sucesso = true;
+
+    if (!argumentosConfiguracaoFrota(argc, argv, 6, &config)) {
+        return 1;
+    }
+    if (!configuracaoFrotaValida(&config) || !abrirEscritor(&escritor, argv[2], tipo, config.quantidade_navios)) {
+        fprintf(stderr, "Erro: nao foi possivel criar o arquivo %s.\n", argv[2]);
+        return 1;
+    }
+    semearGerador(&gerador, semente);
+
+    uint64_t inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade && sucesso; i++) {
+        Frota frota;
+        if (!gerarFrota(&gerador, &config, &frota)) {
+            sucesso = false;
+        } else if (tipo == REGISTRO_BITBOARD) {
+            TabuleiroBits bits;
+            limparTabuleiroBits(&bits);
+            bits.navios = frota.navios;
+            bits.ocupadas |= frota.navios;
+            sucesso = escreverTabuleiroBits(&escritor, &bits);
+        } else {
+            sucesso = escreverFrota(&escritor, &frota);
+        }
+    }
+    sucesso &= fecharEscritor(&escritor);
+    double segundos = (double)(tempoNanossegundos() - inicio) / 1e9;
+
+    if (!sucesso) {
+        fprintf(stderr, "Erro: falha ao gravar %s.\n", argv[2]);
+        return 1;
+    }
+    printf("Registros gravados: %lld em %.3f s (%.0f registros/s)\n", quantidade, segundos,
+           (double)quantidade / segundos);
+    return 0;
+}
+
+// Modo "ler": mostra registros de um arquivo binário, ou varre o arquivo inteiro
+// Uso: ler <arquivo> [primeiro] [quantidade]  (sem índice: varredura com estatísticas)
+static int modoLer(int argc, char *argv[]) {
+    LeitorRegistros leitor;
+
+    if (argc < 3 || !abrirLeitor(&leitor, argv[2])) {
+        fprintf(stderr, "Erro: arquivo invalido ou inexistente.\n");
+        return 1;
+    }
+    printf("Arquivo: %s, versao %d, registros %s, %llu registros de %zu bytes\n", argv[2], ARQUIVO_VERSAO,
+           leitor.tipo == REGISTRO_BITBOARD ? "bitboard" : "navios",
+           (unsigned long long)leitor.quantidade, leitor.bytes_registro);
+
+    if (argc > 3) {
+        long long primeiro = argumentoInteiro(argc, argv, 3, 0);
+        long long quantidade = argumentoInteiro(argc, argv, 4, 1);
+        for (long long i = primeiro; i < primeiro + quantidade && i >= 0 && (uint64_t)i < leitor.quantidade; i++) {
+            int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+            printf("--- Registro %lld ---\n", i);
+            if (lerRegistroMatriz(&leitor, (uint64_t)i, tabuleiro)) {
+                exibirTabuleiro(tabuleiro);
             } else {
-                matriz_habilidade[r][c] = 0;
+                printf("Registro invalido.\n\n");
             }
         }
+        fecharLeitor(&leitor);
+        return 0;
     }
+
+    // Varredura completa: reconstrói cada tabuleiro e conta as células de navio
+    uint64_t celulas_navio = 0, invalidos = 0;
+    uint64_t inicio = tempoNanossegundos();
+    for (uint64_t i = 0; i < leitor.quantidade; i++) {
+        TabuleiroBits bits;
+        if (lerRegistroBits(&leitor, i, &bits)) {
+            celulas_navio += (uint64_t)contarBits(bits.navios);
+        } else {
+            invalidos++;
+        }
+    }
+    double segundos = (double)(tempoNanossegundos() - inicio) / 1e9;
+    printf("Celulas de navio: %llu, registros invalidos: %llu\n",
+           (unsigned long long)celulas_navio, (unsigned long long)invalidos);
+    printf("Varredura: %.3f s (%.0f registros/s)\n", segundos,
+           segundos > 0 ? (double)leitor.quantidade / segundos : 0.0);
+    fecharLeitor(&leitor);
+    return 0;
+}
+
+// Função auxiliar para o número de núcleos disponíveis (mínimo 1)
+static int numeroNucleos(void) {
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    return nucleos > 0 ? (int)nucleos : 1;
 }
 
-// Função para criar a matriz de habilidade em forma de CRUZ
-void criarHabilidadeCruz(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]) {
-    int r, c;
-    for (r = 0; r < HABILIDADE_TAMANHO; r++) {
-        for (c = 0; c < HABILIDADE_TAMANHO; c++) {
-            // Lógica para formar uma cruz centrada
+// Modo "enumerar": conta todas as frotas de navios iguais e as classes de simetria
+// Com um arquivo, grava também uma frota canônica por classe (registros de navios).
+// Uso: enumerar [navios] [tamanho] [threads] [arquivo]  (threads 0 = todos os núcleos)
+static int modoEnumerar(int argc, char *argv[]) {
+    static TabelasEnumeracao tabelas;
+    ResultadoEnumeracao resultado;
+    int navios = (int)argumentoInteiro(argc, argv, 2, 4);
+    int size = (int)argumentoInteiro(argc, argv, 3, TAMANHO_NAVIO);
+    int threads = (int)argumentoInteiro(argc, argv, 4, 0);
+
+    if (threads <= 0) {
+        threads = numeroNucleos();
+    }
+    if (!prepararEnumeracao(&tabelas, size)) {
+        fprintf(stderr, "Erro: tamanho de navio invalido (2 a %d).\n", TABULEIRO_TAMANHO);
+        return 1;
+    }
+
+    uint64_t inicio = tempoNanossegundos();
+    if (!contarFrotas(&tabelas, navios, threads, &resultado)) {
+        fprintf(stderr, "Erro: quantidade de navios invalida (1 a %d).\n", MAX_NAVIOS_FROTA);
+        return 1;
+    }
+    double segundos = (double)(tempoNanossegundos() - inicio) / 1e9;
+
+    printf("Frotas de %d navios de tamanho %d (%d posicionamentos, %d threads)\n", navios, size,
+           tabelas.quantidade, threads);
+    printf("Frotas legais: %llu (%.3f s)\n", (unsigned long long)resultado.frotas, segundos);
+    printf("Invariantes por simetria:");
+    for (int g = 0; g < NUM_SIMETRIAS; g++) {
+        printf(" %llu", (unsigned long long)resultado.fixas[g]);
+    }
+    printf("\nClasses de simetria: %llu\n", (unsigned long long)resultado.classes);
+
+    if (argc > 5) {
+        EscritorRegistros escritor;
+        if (!abrirEscritor(&escritor, argv[5], REGISTRO_NAVIOS, navios)) {
+            fprintf(stderr, "Erro: nao foi possivel criar o arquivo %s.\n", argv[5]);
+            return 1;
+        }
+        inicio = tempoNanossegundos();
+        long long canonicas = enumerarFrotasCanonicas(&tabelas, navios, threads, &escritor);
+        bool gravou = fecharEscritor(&escritor);
+        segundos = (double)(tempoNanossegundos() - inicio) / 1e9;
+        if (canonicas < 0 || !gravou) {
+            fprintf(stderr, "Erro: falha ao gravar %s.\n", argv[5]);
+            return 1;
+        }
+        printf("Frotas canonicas gravadas: %lld (%.3f s)%s\n", canonicas, segundos,
+               (uint64_t)canonicas == resultado.classes ? "" : " - DIFERENTE das classes!");
+        return (uint64_t)canonicas == resultado.classes ? 0 : 1;
+    }
+    return 0;
+}
+
+// Modo "mapa-calor": acumula habilidades sorteadas sobre uma frota sorteada e exibe o mapa
+// de calor, com o tempo de acumulação por habilidade
+// Uso: mapa-calor [habilidades] [semente] [tamanhos...]
+static int modoMapaCalor(int argc, char *argv[]) {
+    static const MascaraHabilidade formas[] = {MASCARA_CONE, MASCARA_CRUZ, MASCARA_OCTAEDRO};
+    long long quantidade = argumentoInteiro(argc, argv, 2, 12);
+    uint64_t semente = (uint64_t)argumentoInteiro(argc, argv, 3, 1);
+    int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO] = {{VALOR_AGUA}};
+    static TabelaCarimbos tabelas[3];
+    ConfiguracaoFrota config;
+    GeradorAleatorio gerador;
+    CamadaIntensidade camada;
+    Frota frota;
+
+    if (!argumentosConfiguracaoFrota(argc, argv, 4, &config)) {
+        return 1;
+    }
+    semearGerador(&gerador, semente);
+    if (!gerarFrota(&gerador, &config, &frota)) {
+        fprintf(stderr, "Erro: configuracao de frota invalida.\n");
+        return 1;
+    }
+    posicionarFrota(tabuleiro, &frota, &config);
+    iniciarCamadaIntensidade(&camada, tabuleiro);
+    for (int f = 0; f < 3; f++) {
+        prepararCarimbos(&tabelas[f], formas[f]);
+    }
+
+    // Origens sorteadas antes, para medir só a acumulação
+    uint8_t *origens = malloc((size_t)(quantidade > 0 ? quantidade : 1));
+    if (origens == NULL) {
+        fprintf(stderr, "Erro: memoria insuficiente.\n");
+        return 1;
+    }
+    for (long long i = 0; i < quantidade; i++) {
+        origens[i] = (uint8_t)aleatorioAte(&gerador, TABULEIRO_CELULAS);
+    }
+
+    uint64_t inicio = tempoNanossegundos();
+    for (long long i = 0; i < quantidade; i++) {
+        acumularCarimbo(&camada, tabelas[i % 3].carimbo[origens[i]]);
+    }
+    double ns = quantidade > 0 ? (double)(tempoNanossegundos() - inicio) / (double)quantidade : 0.0;
+    free(origens);
+
+    int maxima = 0;
+    for (int celula = 0; celula < TABULEIRO_CELULAS; celula++) {
+        maxima = MAXIMO(maxima, intensidadeCelula(&camada, celula));
+    }
+    printf("--- Mapa de calor: %lld habilidades (cone, cruz e octaedro alternados) ---\n", camada.habilidades);
+    exibirMapaCalor(&camada);
+    printf("Celulas de navio atingidas: %d de %d\n", contarBits(camada.navios_atingidos), contarBits(camada.navios));
+    printf("Intensidade maxima: %d%s\n", maxima, maxima == INTENSIDADE_MAXIMA ? " (saturada)" : "");
+    printf("Acumulacao: %.1f ns/habilidade\n", ns);
+    return 0;
+}
+
+// Modo "simular": Monte Carlo dos acertos esperados de cada habilidade em cada origem
+// Uso: simular [frotas] [threads] [semente] [tamanhos...]  (threads 0 = todos os núcleos)
+static int modoSimular(int argc, char *argv[]) {
+    static const char *nomes[] = {"CONE", "CRUZ", "OCTAEDRO"};
+    ConfiguracaoSimulacao config;
+    static ResultadoSimulacao resultado;
+
+    config.frotas = argumentoInteiro(argc, argv, 2, 1000000);
+    config.threads = (int)argumentoInteiro(argc, argv, 3, 0);
+    config.semente = (uint64_t)argumentoInteiro(argc, argv, 4, 1);
+    if (config.threads <= 0) {
+        config.threads = numeroNucleos();
+    }
+    if (!argumentosConfiguracaoFrota(argc, argv, 5, &config.frota)) {
+        return 1;
+    }
+    config.num_formas = 3;
+    config.formas[0] = MASCARA_CONE;
+    config.formas[1] = MASCARA_CRUZ;
+    config.formas[2] = MASCARA_OCTAEDRO;
+
+    uint64_t inicio = tempoNanossegundos();
+    if (!simularHabilidades(&config, &resultado)) {
+        fprintf(stderr, "Erro: configuracao de simulacao invalida.\n");
+        return 1;
+    }
+    double segundos = (double)(tempoNanossegundos() - inicio) / 1e9;
+
+    for (int f = 0; f < config.num_formas; f++) {
+        printf("--- Acertos esperados por origem - %s ---\n", nomes[f]);
+        for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+            for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+                double media = resultado.frotas > 0
+                    ? (double)resultado.acertos[f][r * TABULEIRO_TAMANHO + c] / (double)resultado.frotas
+                    : 0.0;
+                printf("%5.2f ", media);
+            }
+            printf("\n");
+        }
+        printf("\n");
+    }
+
+    double ensaios = (double)resultado.frotas * config.num_formas * TABULEIRO_CELULAS;
+    printf("Frotas: %lld, threads: %d, tempo: %.3f s\n", resultado.frotas, config.threads, segundos);
+    printf("Ensaios (frota, habilidade, origem)/segundo: %.0f\n", ensaios / segundos);
+    return 0;
+}
+
+// Nomes das estratégias do torneio, na ordem de EstrategiaTiro e EstrategiaPosicionamento
+static const char *nomes_tiro[NUM_ESTRATEGIAS_TIRO] = {"aleatorio", "caca", "paridade"};
+static const char *nomes_posicionamento[NUM_ESTRATEGIAS_POSICIONAMENTO] = {"aleatorio", "reto", "bordas"};
+
+// Função auxiliar para interpretar um jogador do torneio no formato "<tiro>:<posicionamento>"
+// O posicionamento é opcional (aleatório). Retorna false para nomes desconhecidos.
+static bool interpretarJogador(const char *texto, EstrategiaJogador *jogador) {
+    const char *separador = strchr(texto, ':');
+    size_t tamanho_tiro = separador != NULL ? (size_t)(separador - texto) : strlen(texto);
+    int tiro = -1, posicionamento = separador != NULL ? -1 : POSICIONAMENTO_ALEATORIO;
+
+    for (int i = 0; i < NUM_ESTRATEGIAS_TIRO; i++) {
+        if (strlen(nomes_tiro[i]) == tamanho_tiro && strncmp(texto, nomes_tiro[i], tamanho_tiro) == 0) {
+            tiro = i;
+        }
+    }
+    for (int i = 0; separador != NULL && i < NUM_ESTRATEGIAS_POSICIONAMENTO; i++) {
+        if (strcmp(separador + 1, nomes_posicionamento[i]) == 0) {
+            posicionamento = i;
+        }
+    }
+    jogador->tiro = (EstrategiaTiro)tiro;
+    jogador->posicionamento = (EstrategiaPosicionamento)posicionamento;
+    return tiro >= 0 && posicionamento >= 0;
+}
+
+// Modo "torneio": partidas completas entre dois jogadores, com taxa de vitória e intervalo de
+// confiança de Wilson (95%) de cada um
+// Jogadores no formato <tiro>:<posicionamento>; tiro aleatorio, caca ou paridade e posicionamento
+// aleatorio, reto ou bordas. Cada jogador tem uma carga de cada habilidade por partida.
+// Só o posicionamento aleatorio usa navios diagonais; contra ele, caca e paridade também
+// perseguem as vizinhas diagonais e a paridade sorteia as células de linha ou coluna par.
+// Uso: torneio [partidas] [threads] [semente] [jogadorA] [jogadorB] [tamanhos...]  (threads 0 = todos os núcleos)
+static int modoTorneio(int argc, char *argv[]) {
+    const char *textos[2] = {argc > 5 ? argv[5] : "paridade:aleatorio", argc > 6 ? argv[6] : "caca:aleatorio"};
+    ConfiguracaoTorneio config;
+    ResultadoTorneio resultado;
+
+    config.partidas = argumentoInteiro(argc, argv, 2, 1000000);
+    config.threads = (int)argumentoInteiro(argc, argv, 3, 0);
+    config.semente = (uint64_t)argumentoInteiro(argc, argv, 4, 1);
+    config.cargas_habilidade = 1;
+    if (config.threads <= 0) {
+        config.threads = numeroNucleos();
+    }
+    if (!argumentosConfiguracaoFrota(argc, argv, 7, &config.frota)) {
+        return 1;
+    }
+    for (int j = 0; j < 2; j++) {
+        if (!interpretarJogador(textos[j], &config.jogadores[j])) {
+            fprintf(stderr, "Erro: jogador invalido: %s (use <aleatorio|caca|paridade>:<aleatorio|reto|bordas>)\n",
+                    textos[j]);
+            return 1;
+        }
+    }
+
+    uint64_t inicio = tempoNanossegundos();
+    if (!executarTorneio(&config, &resultado)) {
+        fprintf(stderr, "Erro: configuracao de torneio invalida.\n");
+        return 1;
+    }
+    double segundos = (double)(tempoNanossegundos() - inicio) / 1e9;
+
+    printf("Partidas: %lld, threads: %d, semente: %llu\n", resultado.partidas, config.threads,
+           (unsigned long long)config.semente);
+    for (int j = 0; j < 2; j++) {
+        // Metade das partidas (arredondada para cima no jogador A) começa com cada jogador
+        uint64_t iniciadas = (uint64_t)(resultado.partidas + (j == 0)) / 2;
+        double inferior, superior, inferior_inicio, superior_inicio;
+
+        intervaloWilson(resultado.vitorias[j], (uint64_t)resultado.partidas, 1.96, &inferior, &superior);
+        intervaloWilson(resultado.vitorias_iniciando[j], iniciadas, 1.96, &inferior_inicio, &superior_inicio);
+        printf("Jogador %c (%s:%s): %llu vitorias, %.2f%% [IC 95%%: %.2f%% - %.2f%%]\n", 'A' + j,
+               nomes_tiro[config.jogadores[j].tiro], nomes_posicionamento[config.jogadores[j].posicionamento],
+               (unsigned long long)resultado.vitorias[j],
+               resultado.partidas > 0 ? 100.0 * (double)resultado.vitorias[j] / (double)resultado.partidas : 0.0,
+               100.0 * inferior, 100.0 * superior);
+        printf("  comecando: %llu de %llu, %.2f%% [IC 95%%: %.2f%% - %.2f%%]\n",
+               (unsigned long long)resultado.vitorias_iniciando[j], (unsigned long long)iniciadas,
+               iniciadas > 0 ? 100.0 * (double)resultado.vitorias_iniciando[j] / (double)iniciadas : 0.0,
+               100.0 * inferior_inicio, 100.0 * superior_inicio);
+    }
+    printf("Disparos medios do vencedor: %.2f\n",
+           resultado.partidas > 0 ? (double)resultado.disparos_vencedor / (double)resultado.partidas : 0.0);
+    printf("Tempo: %.3f s (%.0f partidas/s)\n", segundos, (double)resultado.partidas / segundos);
+    return 0;
+}
+
+// Função auxiliar para sortear um cenário do modo "lote": 1 a 5 navios de tamanho 1 a 5 (alguns
+// fora dos limites ou sobrepostos, para exercitar as recusas) e 0 a 4 habilidades, inclusive
+// com origem fora do tabuleiro
+static void sortearCenario(GeradorAleatorio *gerador, Cenario *cenario) {
+    cenario->quantidade_navios = 1 + (int)aleatorioAte(gerador, 5);
+    for (int i = 0; i < cenario->quantidade_navios; i++) {
+        NavioCenario *navio = &cenario->navios[i];
+        navio->linha = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO + 2) - 1;
+        navio->coluna = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO + 2) - 1;
+        navio->orientacao = (OrientacaoNavio)aleatorioAte(gerador, NUM_ORIENTACOES);
+        navio->tamanho = 1 + (int)aleatorioAte(gerador, 5);
+    }
+    cenario->quantidade_habilidades = (int)aleatorioAte(gerador, 5);
+    for (int i = 0; i < cenario->quantidade_habilidades; i++) {
+        HabilidadeCenario *habilidade = &cenario->habilidades[i];
+        habilidade->forma = (IdHabilidade)aleatorioAte(gerador, NUM_HABILIDADES_PADRAO);
+        habilidade->linha = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO + 6) - 3;
+        habilidade->coluna = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO + 6) - 3;
+    }
+}
+
+// Função auxiliar para escrever um cenário no formato de texto do modo "lote"
+// O tamanho do navio só é escrito quando difere de TAMANHO_NAVIO.
+static void escreverCenario(FILE *saida, const Cenario *cenario) {
+    static const char orientacoes[NUM_ORIENTACOES] = {'H', 'V', 'S', 'D'}; // Ordem de OrientacaoNavio
+    static const char *formas[NUM_HABILIDADES_PADRAO] = {"cone", "cruz", "octaedro"};
+
+    for (int i = 0; i < cenario->quantidade_navios; i++) {
+        const NavioCenario *navio = &cenario->navios[i];
+        fprintf(saida, "%sN %d %d %c", i > 0 ? " " : "", navio->linha, navio->coluna,
+                orientacoes[navio->orientacao]);
+        if (navio->tamanho != TAMANHO_NAVIO) {
+            fprintf(saida, " %d", navio->tamanho);
+        }
+    }
+    for (int i = 0; i < cenario->quantidade_habilidades; i++) {
+        const HabilidadeCenario *habilidade = &cenario->habilidades[i];
+        fprintf(saida, " A %s %d %d", formas[habilidade->forma], habilidade->linha, habilidade->coluna);
+    }
+    fputc('\n', saida);
+}
+
+// Modo "gerar-cenarios": escreve cenários sorteados na saída padrão, para o modo "lote"
+// Uso: gerar-cenarios [quantidade] [semente]
+static int modoGerarCenarios(int argc, char *argv[]) {
+    long long quantidade = argumentoInteiro(argc, argv, 2, 1000000);
+    GeradorAleatorio gerador;
+    Cenario cenario;
+
+    semearGerador(&gerador, (uint64_t)argumentoInteiro(argc, argv, 3, 1));
+    for (long long i = 0; i < quantidade; i++) {
+        sortearCenario(&gerador, &cenario);
+        escreverCenario(stdout, &cenario);
+    }
+    return 0;
+}
+
+// Modo "lote": processa cenários de um arquivo (ou da entrada padrão) em paralelo
+// Os resultados vão para a saída padrão, na ordem da entrada; o resumo vai para a saída de erro.
+// Uso: lote [arquivo|-] [threads]  (threads 0 = todos os núcleos)
+static int modoLote(int argc, char *argv[]) {
+    const char *caminho = argc > 2 ? argv[2] : "-";
+    int threads = (int)argumentoInteiro(argc, argv, 3, 0);
+    EstatisticasLote estatisticas;
+
+    if (threads <= 0) {
+        threads = numeroNucleos();
+    }
+    FILE *entrada = strcmp(caminho, "-") == 0 ? stdin : fopen(caminho, "r");
+    if (entrada == NULL) {
+        fprintf(stderr, "Erro: nao foi possivel abrir %s.\n", caminho);
+        return 1;
+    }
+
+    uint64_t inicio = tempoNanossegundos();
+    bool sucesso = processarLote(entrada, stdout, threads, &estatisticas);
+    sucesso &= fflush(stdout) == 0;
+    double segundos = (double)(tempoNanossegundos() - inicio) / 1e9;
+    if (entrada != stdin) {
+        fclose(entrada);
+    }
+
+    fprintf(stderr, "Cenarios: %llu, com erro: %llu, navios recusados: %llu, threads: %d\n",
+            (unsigned long long)estatisticas.cenarios, (unsigned long long)estatisticas.erros,
+            (unsigned long long)estatisticas.navios_rejeitados, threads);
+    fprintf(stderr, "Tempo: %.3f s (%.0f cenarios/s)\n", segundos,
+            segundos > 0 ? (double)estatisticas.cenarios / segundos : 0.0);
+    if (!sucesso) {
+        fprintf(stderr, "Erro: falha de leitura, escrita ou memoria no processamento em lote.\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Verificação da enumeração: contagens por força bruta (pares e trios de máscaras
+// disjuntas), canônicas iguais às classes de Burnside e resultado independente de threads.
+// A contagem SWAR dos conjuntos é comparada antes com __builtin_popcountll.
+static int verificarEnumeracao(GeradorAleatorio *gerador) {
+    static TabelasEnumeracao tabelas;
+    int falhas = 0;
+
+    // Contagem de conjuntos densos (inclusive todos os bits ligados) contra o popcount simples
+    for (int caso = 0; caso < 1000; caso++) {
+        ConjuntoPosicionamentos conjunto;
+        int esperado = 0;
+        for (int w = 0; w < PALAVRAS_POSICIONAMENTOS; w++) {
+            conjunto.palavras[w] = caso == 0 ? ~0ULL : proximoAleatorio(gerador) | proximoAleatorio(gerador);
+            esperado += __builtin_popcountll(conjunto.palavras[w]);
+        }
+        if (contarPosicionamentos(&conjunto) != esperado && falhas++ < 5) {
+            printf("FALHA enumeracao: contagem do conjunto %d\n", caso);
+        }
+    }
+
+    for (int size = 2; size <= 5; size++) {
+        int n;
+        const PosicionamentoNavio *base = posicionamentosDoTamanho(size, &n);
+        uint64_t esperado[4] = {0, (uint64_t)n, 0, 0};
+        for (int a = 0; a < n; a++) {
+            for (int b = a + 1; b < n; b++) {
+                if (base[a].mascara & base[b].mascara) {
+                    continue;
+                }
+                esperado[2]++;
+                for (int c = b + 1; c < n; c++) {
+                    esperado[3] += ((base[a].mascara | base[b].mascara) & base[c].mascara) == 0;
+                }
+            }
+        }
+
+        prepararEnumeracao(&tabelas, size);
+        for (int navios = 1; navios <= 3; navios++) {
+            ResultadoEnumeracao r1, r2;
+            bool ok = contarFrotas(&tabelas, navios, 1, &r1) && contarFrotas(&tabelas, navios, 3, &r2) &&
+                      r1.frotas == esperado[navios] && r2.frotas == r1.frotas &&
+                      enumerarFrotasCanonicas(&tabelas, navios, 2, NULL) == (long long)r1.classes;
+            if (!ok && falhas++ < 5) {
+                printf("FALHA enumeracao: tamanho %d, %d navios\n", size, navios);
+            }
+        }
+    }
+    printf("Enumeracao: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
+}
+
+// Verificação do registro de desfazer: sequências sorteadas de navios e habilidades
+// (inclusive posicionamentos sobrepostos, sem canPlaceShip) com instantâneos aninhados;
+// cada retorno deve reproduzir a cópia do tabuleiro guardada no instantâneo, e as
+// operações devem dar o mesmo resultado que placeShip/aplicarMascaraHabilidade.
+static int verificarDesfazer(GeradorAleatorio *gerador) {
+    static const MascaraHabilidade formas[] = {MASCARA_CONE, MASCARA_CRUZ, MASCARA_OCTAEDRO};
+    enum { PROFUNDIDADE = 6, OPERACOES = 8 };
+    int falhas = 0;
+
+    for (int caso = 0; caso < 2000; caso++) {
+        TabuleiroDesfazer tabuleiro;
+        int copias[PROFUNDIDADE][TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+        PontoRestauracao pontos[PROFUNDIDADE];
+        int esperado[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+
+        iniciarTabuleiroDesfazer(&tabuleiro);
+        memcpy(esperado, tabuleiro.celulas, sizeof(esperado));
+        for (int nivel = 0; nivel < PROFUNDIDADE; nivel++) {
+            pontos[nivel] = pontoRestauracao(&tabuleiro);
+            memcpy(copias[nivel], tabuleiro.celulas, sizeof(copias[nivel]));
+            for (int op = 0; op < OPERACOES; op++) {
+                int linha = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO);
+                int coluna = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO);
+                if (aleatorioAte(gerador, 2) == 0) {
+                    int size = 1 + (int)aleatorioAte(gerador, 5);
+                    OrientacaoNavio orientacao = (OrientacaoNavio)aleatorioAte(gerador, NUM_ORIENTACOES);
+                    if (mascaraNavio(linha, coluna, size, orientacao) & BITBOARD_FORA) {
+                        continue; // placeShip não aceita posicionamentos fora do tabuleiro
+                    }
+                    placeShip(esperado, linha, coluna, size, orientacao);
+                    placeShipDesfazer(&tabuleiro, linha, coluna, size, orientacao);
+                } else {
+                    MascaraHabilidade forma = formas[aleatorioAte(gerador, 3)];
+                    aplicarMascaraHabilidade(esperado, forma, linha, coluna);
+                    aplicarMascaraHabilidadeDesfazer(&tabuleiro, forma, linha, coluna);
+                }
+            }
+            if (memcmp(esperado, tabuleiro.celulas, sizeof(esperado)) != 0 && falhas++ < 5) {
+                printf("FALHA desfazer: caso %d, operacoes do nivel %d\n", caso, nivel);
+            }
+        }
+
+        // Retorna a instantâneos sorteados, do mais recente para o mais antigo
+        for (int nivel = PROFUNDIDADE - 1; nivel >= 0; nivel -= 1 + (int)aleatorioAte(gerador, 2)) {
+            restaurarTabuleiro(&tabuleiro, pontos[nivel]);
+            if (memcmp(copias[nivel], tabuleiro.celulas, sizeof(copias[nivel])) != 0 && falhas++ < 5) {
+                printf("FALHA desfazer: caso %d, retorno ao nivel %d\n", caso, nivel);
+            }
+        }
+    }
+    printf("Desfazer: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
+}
+
+// Verificação do formato binário: frotas gravadas nos dois tipos de registro devem ser
+// reconstruídas idênticas pelo leitor, e o arquivo truncado só perde o registro incompleto
+static int verificarArquivo(GeradorAleatorio *gerador) {
+    enum { FROTAS_ARQUIVO = 500 };
+    static const TipoRegistro tipos[] = {REGISTRO_BITBOARD, REGISTRO_NAVIOS};
+    ConfiguracaoFrota config = {5, {5, 4, 3, 3, 2}};
+    Frota frotas[FROTAS_ARQUIVO];
+    char caminho[] = "/tmp/batalhaNavalXXXXXX";
+    int falhas = 0;
+
+    int descritor = mkstemp(caminho);
+    if (descritor < 0 || gerarFrotas(gerador, &config, frotas, FROTAS_ARQUIVO) != FROTAS_ARQUIVO) {
+        printf("FALHA arquivo: preparacao\n");
+        return 1;
+    }
+    close(descritor);
+
+    for (int k = 0; k < 2; k++) {
+        EscritorRegistros escritor;
+        LeitorRegistros leitor;
+        bool gravou = abrirEscritor(&escritor, caminho, tipos[k], config.quantidade_navios);
+        for (int i = 0; i < FROTAS_ARQUIVO && gravou; i++) {
+            TabuleiroBits bits;
+            limparTabuleiroBits(&bits);
+            bits.navios = frotas[i].navios;
+            bits.ocupadas |= frotas[i].navios;
+            gravou = tipos[k] == REGISTRO_BITBOARD ? escreverTabuleiroBits(&escritor, &bits)
+                                                   : escreverFrota(&escritor, &frotas[i]);
+        }
+        if (!gravou || !fecharEscritor(&escritor) || truncate(caminho, ARQUIVO_CABECALHO +
+                (off_t)bytesRegistro(tipos[k], config.quantidade_navios) * FROTAS_ARQUIVO - 1) != 0 ||
+            !abrirLeitor(&leitor, caminho)) {
+            printf("FALHA arquivo: tipo %d nao gravado\n", tipos[k]);
+            falhas++;
+            continue;
+        }
+        if (leitor.quantidade != FROTAS_ARQUIVO - 1) {
+            printf("FALHA arquivo: tipo %d com %llu registros\n", tipos[k], (unsigned long long)leitor.quantidade);
+            falhas++;
+        }
+        for (uint64_t i = 0; i < leitor.quantidade; i++) {
+            TabuleiroBits bits;
+            if (!lerRegistroBits(&leitor, i, &bits) || bits.navios != frotas[i].navios) {
+                if (falhas++ < 5) {
+                    printf("FALHA arquivo: tipo %d, registro %llu\n", tipos[k], (unsigned long long)i);
+                }
+            }
+        }
+        fecharLeitor(&leitor);
+    }
+    remove(caminho);
+    printf("Arquivo: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
+}
+
+// Modo "verificar": confere as versões otimizadas contra as implementações de referência
+// Retorna 0 se todas as verificações passarem.
+
+// Função auxiliar para sortear um tabuleiro com água, navios, habilidades e (opcionalmente)
+// valores inesperados, que as funções de matriz devem preservar
+static void sortearTabuleiroVerificacao(GeradorAleatorio *gerador,
+                                        int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                                        bool valores_inesperados) {
+    static const int valores[] = {VALOR_AGUA, VALOR_AGUA, VALOR_AGUA, VALOR_NAVIO, VALOR_HABILIDADE, 7};
+    int opcoes = valores_inesperados ? 6 : 5;
+
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            tabuleiro[r][c] = valores[aleatorioAte(gerador, (uint32_t)opcoes)];
+        }
+    }
+}
+
+// Verificação exaustiva de aplicarHabilidadeAoTabuleiro e aplicarHabilidadeBits:
+// todas as origens (inclusive as que deixam a habilidade parcial ou totalmente fora do
+// tabuleiro), as três formas e matrizes sorteadas, sobre vários tabuleiros.
+static int verificarHabilidades(GeradorAleatorio *gerador) {
+    int matrizes[8][HABILIDADE_TAMANHO][HABILIDADE_TAMANHO];
+    int falhas = 0;
+
+    criarHabilidadeCone(matrizes[0]);
+    criarHabilidadeCruz(matrizes[1]);
+    criarHabilidadeOctaedro(matrizes[2]);
+    for (int m = 3; m < 8; m++) {
+        for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
+            for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
+                matrizes[m][r][c] = (int)aleatorioAte(gerador, 3); // Valores 0, 1 e 2 (só 1 afeta)
+            }
+        }
+    }
+
+    for (int caso = 0; caso < 64; caso++) {
+        int base[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+        bool inesperados = caso % 2 == 1;
+        sortearTabuleiroVerificacao(gerador, base, inesperados);
+        if (caso == 0) {
+            memset(base, 0, sizeof(base)); // Tabuleiro vazio
+        }
+
+        for (int m = 0; m < 8; m++) {
+            MascaraHabilidade mascara = compactarHabilidade(matrizes[m]);
+            for (int o_r = -HABILIDADE_TAMANHO; o_r < TABULEIRO_TAMANHO + HABILIDADE_TAMANHO; o_r++) {
+                for (int o_c = -HABILIDADE_TAMANHO; o_c < TABULEIRO_TAMANHO + HABILIDADE_TAMANHO; o_c++) {
+                    int esperado[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+                    int obtido[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+
+                    memcpy(esperado, base, sizeof(base));
+                    memcpy(obtido, base, sizeof(base));
+                    aplicarHabilidadeAoTabuleiroReferencia(esperado, matrizes[m], o_r, o_c);
+                    aplicarHabilidadeAoTabuleiro(obtido, matrizes[m], o_r, o_c);
+                    if (memcmp(esperado, obtido, sizeof(esperado)) != 0) {
+                        if (falhas++ < 5) {
+                            printf("FALHA aplicarHabilidadeAoTabuleiro: matriz %d origem (%d,%d)\n", m, o_r, o_c);
+                        }
+                    }
+
+                    if (!inesperados) {
+                        TabuleiroBits bits;
+                        matrizParaBitboard(base, &bits);
+                        aplicarHabilidadeBits(&bits, mascara, o_r, o_c);
+                        bitboardParaMatriz(&bits, obtido);
+                        if (memcmp(esperado, obtido, sizeof(esperado)) != 0) {
+                            if (falhas++ < 5) {
+                                printf("FALHA aplicarHabilidadeBits: matriz %d origem (%d,%d)\n", m, o_r, o_c);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    printf("Habilidades: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
+}
+
+// Verificação das formas geradas em tempo de compilação contra as fórmulas originais
+// (distâncias calculadas com abs) e das variantes do registro de habilidades.
+static int verificarFormasHabilidade(void) {
+    RegistroHabilidades registro;
+    MascaraHabilidade cone = 0, cruz = 0, octaedro = 0;
+    int falhas = 0;
+
+    for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
+        for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
+            if (abs(c - HABILIDADE_CENTRO) <= r) {
+                cone |= HABILIDADE_BIT(r, c);
+            }
             if (r == HABILIDADE_CENTRO || c == HABILIDADE_CENTRO) {
-                matriz_habilidade[r][c] = 1;
-            } else {
-                matriz_habilidade[r][c] = 0;
+                cruz |= HABILIDADE_BIT(r, c);
+            }
+            if (abs(r - HABILIDADE_CENTRO) + abs(c - HABILIDADE_CENTRO) <= HABILIDADE_CENTRO) {
+                octaedro |= HABILIDADE_BIT(r, c);
             }
         }
     }
+    falhas += cone != MASCARA_CONE;
+    falhas += cruz != MASCARA_CRUZ;
+    falhas += octaedro != MASCARA_OCTAEDRO;
+
+    // Cone girado 180 graus aponta para cima: linhas na ordem inversa (a forma é simétrica)
+    iniciarRegistroHabilidades(&registro);
+    MascaraHabilidade para_cima = obterHabilidade(&registro, HABILIDADE_CONE, VARIANTE_ROTACAO_180);
+    for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
+        falhas += HABILIDADE_LINHA(para_cima, r) != HABILIDADE_LINHA(MASCARA_CONE, HABILIDADE_TAMANHO - 1 - r);
+    }
+    for (int id = 0; id < registro.quantidade; id++) {
+        // Quatro giros voltam à forma original; cruz e octaedro são simétricos
+        MascaraHabilidade volta = rotacionarHabilidade(obterHabilidade(&registro, id, VARIANTE_ROTACAO_270));
+        falhas += volta != obterHabilidade(&registro, id, VARIANTE_ORIGINAL);
+    }
+    for (int v = 0; v < NUM_VARIANTES_HABILIDADE; v++) {
+        falhas += obterHabilidade(&registro, HABILIDADE_CRUZ, (VarianteHabilidade)v) != MASCARA_CRUZ;
+        falhas += obterHabilidade(&registro, HABILIDADE_OCTAEDRO, (VarianteHabilidade)v) != MASCARA_OCTAEDRO;
+    }
+    printf("Formas de habilidade: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
 }
 
-// Função para criar a matriz de habilidade em forma de OCTAEDRO (losango)
-void criarHabilidadeOctaedro(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]) {
-    int r, c;
-    int raio = HABILIDADE_CENTRO; // Raio máximo do losango (distância do centro até a borda)
+// Verificação do solver: a cada tiro de partidas completas, as densidades mantidas
+// incrementalmente devem ser iguais às recontadas do zero com canPlaceShip, usando um
+// tabuleiro em que tiros na água e navios afundados ocupam as células.
+static int verificarSolver(GeradorAleatorio *gerador) {
+    static SolverTiros solver;
+    ConfiguracaoFrota config = {5, {5, 4, 3, 3, 2}};
+    int falhas = 0;
+
+    for (int partida = 0; partida < 50; partida++) {
+        Frota frota;
+        Bitboard restantes[MAX_NAVIOS_FROTA];
+        int navios_no_mar = config.quantidade_navios;
+
+        gerarFrota(gerador, &config, &frota);
+        iniciarSolver(&solver, &config);
+        for (int i = 0; i < config.quantidade_navios; i++) {
+            restantes[i] = posicionamentoPorIndice(frota.posicionamento[i])->mascara;
+        }
+
+        while (navios_no_mar > 0) {
+            int celula = escolherTiro(&solver);
+            Bitboard bit = (Bitboard)1 << celula;
+            bool acertou = (frota.navios & bit) != 0;
 
-    for (r = 0; r < HABILIDADE_TAMANHO; r++) {
-        for (c = 0; c < HABILIDADE_TAMANHO; c++) {
-            // Lógica para formar um losango (octaedro 2D)
-            // abs(r - HABILIDADE_CENTRO) + abs(c - HABILIDADE_CENTRO) calcula a "distância Manhattan" do centro
-            if (abs(r - HABILIDADE_CENTRO) + abs(c - HABILIDADE_CENTRO) <= raio) {
-                matriz_habilidade[r][c] = 1;
-            } else {
-                matriz_habilidade[r][c] = 0;
-            }
-        }
-    }
-}
-
-// Função para aplicar a área de efeito de uma habilidade ao tabuleiro principal
-// origin_row, origin_col: centro da habilidade no tabuleiro principal.
-void aplicarHabilidadeAoTabuleiro(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
-                                 int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO],
-                                 int origin_row, int origin_col) {
-    int r_hab, c_hab; // Coordenadas na matriz de habilidade
-    int r_tab, c_tab; // Coordenadas correspondentes no tabuleiro principal
-
-    // Itera sobre a matriz de habilidade
-    for (r_hab = 0; r_hab < HABILIDADE_TAMANHO; r_hab++) {
-        for (c_hab = 0; c_hab < HABILIDADE_TAMANHO; c_hab++) {
-            // Se a célula na matriz de habilidade é afetada (valor 1)
-            if (matriz_habilidade[r_hab][c_hab] == 1) {
-                // Calcula a coordenada correspondente no tabuleiro principal,
-                // centrando a habilidade no ponto de origem.
-                r_tab = origin_row + (r_hab - HABILIDADE_CENTRO);
-                c_tab = origin_col + (c_hab - HABILIDADE_CENTRO);
-
-                // --- Validação de Limites ---
-                // Verifica se a posição calculada está dentro dos limites do tabuleiro principal
-                if (r_tab >= 0 && r_tab < TABULEIRO_TAMANHO &&
-                    c_tab >= 0 && c_tab < TABULEIRO_TAMANHO) {
-                    // --- Sobreposição da Habilidade ---
-                    // Se a posição no tabuleiro principal é água (0), marca como área de habilidade (5).
-                    // Navios (3) permanecem como navios, não são sobrescritos por habilidades visuais neste nível.
-                    if (tabuleiro[r_tab][c_tab] == VALOR_AGUA) {
-                        tabuleiro[r_tab][c_tab] = VALOR_HABILIDADE;
+            registrarTiro(&solver, celula / TABULEIRO_TAMANHO, celula % TABULEIRO_TAMANHO, acertou);
+            for (int i = 0; acertou && i < config.quantidade_navios; i++) {
+                if ((restantes[i] & bit) && (restantes[i] &= ~bit) == 0) {
+                    registrarAfundado(&solver, frota.posicionamento[i]);
+                    navios_no_mar--;
+                }
+            }
+
+            // Recontagem do zero
+            int bloqueio[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+            for (int c = 0; c < TABULEIRO_CELULAS; c++) {
+                Bitboard b = (Bitboard)1 << c;
+                bool ocupada = ((solver.tiros & ~solver.acertos) | solver.afundados) & b;
+                bloqueio[c / TABULEIRO_TAMANHO][c % TABULEIRO_TAMANHO] = ocupada ? VALOR_NAVIO : VALOR_AGUA;
+            }
+            for (int t = 0; t < solver.num_tamanhos; t++) {
+                int32_t densidade[TABULEIRO_CELULAS] = {0}, alvo[TABULEIRO_CELULAS] = {0};
+                int quantidade;
+                const PosicionamentoNavio *tabela = posicionamentosDoTamanho(solver.tamanhos[t], &quantidade);
+                for (int i = 0; i < quantidade; i++) {
+                    const PosicionamentoNavio *p = &tabela[i];
+                    if (!canPlaceShip(bloqueio, p->linha, p->coluna, p->tamanho, (OrientacaoNavio)p->orientacao)) {
+                        continue;
+                    }
+                    int acertos_cobertos = contarBits(p->mascara & solver.acertos);
+                    Bitboard m = p->mascara;
+                    while (m) {
+                        int c = extrairCelula(&m);
+                        densidade[c]++;
+                        alvo[c] += acertos_cobertos;
+                    }
+                }
+                if (memcmp(densidade, solver.densidade[t], sizeof(densidade)) != 0 ||
+                    memcmp(alvo, solver.densidade_alvo[t], sizeof(alvo)) != 0) {
+                    if (falhas++ < 5) {
+                        printf("FALHA solver: partida %d, tamanho %d\n", partida, solver.tamanhos[t]);
+                    }
+                }
+            }
+        }
+    }
+    printf("Solver: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
+}
+
+// Verificação do renderizador: a saída em buffer deve ser byte a byte igual à da
+// implementação com fprintf, inclusive para valores inesperados (negativos e extremos)
+static int verificarRenderizador(GeradorAleatorio *gerador) {
+    static const int extremos[] = {-2147483647 - 1, 2147483647, -1, 10, 1234};
+    int falhas = 0;
+
+    for (int caso = 0; caso < 200; caso++) {
+        int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+        char esperado[RENDERIZACAO_MAX_COMPLETO + 1];
+        char obtido[RENDERIZACAO_MAX_COMPLETO];
+
+        sortearTabuleiroVerificacao(gerador, tabuleiro, caso % 2 == 1);
+        if (caso % 4 == 3) {
+            for (int i = 0; i < 5; i++) {
+                tabuleiro[aleatorioAte(gerador, TABULEIRO_TAMANHO)][aleatorioAte(gerador, TABULEIRO_TAMANHO)] = extremos[i];
+            }
+        }
+
+        FILE *memoria = fmemopen(esperado, sizeof(esperado), "w");
+        if (memoria == NULL) {
+            printf("FALHA renderizador: fmemopen\n");
+            return 1;
+        }
+        exibirTabuleiroReferencia(memoria, tabuleiro);
+        long tamanho_esperado = ftell(memoria);
+        fclose(memoria);
+
+        size_t tamanho = renderizarTabuleiro(tabuleiro, obtido, FORMATO_COMPLETO);
+        if ((long)tamanho != tamanho_esperado || memcmp(esperado, obtido, tamanho) != 0) {
+            if (falhas++ < 5) {
+                printf("FALHA renderizador: caso %d\n", caso);
+            }
+        }
+    }
+    printf("Renderizador: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
+}
+
+// Verificação da avaliação em todas as origens: comparação com a versão de referência
+// (cópia + aplicação + varredura) para as três formas e matrizes sorteadas, sobre
+// tabuleiros sorteados, inclusive com valores inesperados
+static int verificarOrigens(GeradorAleatorio *gerador) {
+    int falhas = 0;
+
+    for (int caso = 0; caso < 60; caso++) {
+        int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+        int matriz[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO];
+        TabelaCarimbos tabela;
+        AvaliacaoOrigens esperado, obtido;
+
+        sortearTabuleiroVerificacao(gerador, tabuleiro, caso % 2 == 1);
+        if (caso % 4 == 0) {
+            criarHabilidadeCone(matriz);
+        } else if (caso % 4 == 1) {
+            criarHabilidadeCruz(matriz);
+        } else if (caso % 4 == 2) {
+            criarHabilidadeOctaedro(matriz);
+        } else {
+            for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
+                for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
+                    matriz[r][c] = (int)aleatorioAte(gerador, 2);
+                }
+            }
+        }
+
+        avaliarOrigensReferencia(tabuleiro, matriz, &esperado);
+        prepararCarimbos(&tabela, compactarHabilidade(matriz));
+        avaliarOrigensHabilidade(tabuleiro, &tabela, &obtido);
+        if (memcmp(&esperado, &obtido, sizeof(esperado)) != 0 && falhas++ < 5) {
+            printf("FALHA origens: caso %d\n", caso);
+        }
+    }
+    printf("Origens: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
+}
+
+// Verificação do modo de acumulação: contadores em planos de bits contra contadores
+// inteiros por célula, com saturação (muitas habilidades na mesma origem) e navios atingidos
+static int verificarAcumulacao(GeradorAleatorio *gerador) {
+    static const MascaraHabilidade formas[] = {MASCARA_CONE, MASCARA_CRUZ, MASCARA_OCTAEDRO};
+    int falhas = 0;
+
+    for (int caso = 0; caso < 100; caso++) {
+        int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+        int esperado[TABULEIRO_CELULAS] = {0};
+        int obtido[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+        Bitboard atingidos = 0;
+        CamadaIntensidade camada;
+
+        sortearTabuleiroVerificacao(gerador, tabuleiro, false);
+        iniciarCamadaIntensidade(&camada, tabuleiro);
+        // Poucas origens distintas para os contadores passarem do máximo
+        int habilidades = caso % 10 == 0 ? 600 : (int)aleatorioAte(gerador, 60);
+        int origens = caso % 10 == 0 ? 2 : TABULEIRO_CELULAS;
+        for (int i = 0; i < habilidades; i++) {
+            MascaraHabilidade forma = formas[aleatorioAte(gerador, 3)];
+            int origem = (int)aleatorioAte(gerador, (uint32_t)origens);
+            int linha = origem / TABULEIRO_TAMANHO, coluna = origem % TABULEIRO_TAMANHO;
+            Bitboard carimbo = carimboHabilidade(forma, linha, coluna);
+            for (int celula = 0; celula < TABULEIRO_CELULAS; celula++) {
+                if ((carimbo >> celula) & 1) {
+                    esperado[celula] = MINIMO(esperado[celula] + 1, INTENSIDADE_MAXIMA);
+                    if (tabuleiro[celula / TABULEIRO_TAMANHO][celula % TABULEIRO_TAMANHO] == VALOR_NAVIO) {
+                        atingidos |= (Bitboard)1 << celula;
                     }
                 }
             }
+            acumularHabilidade(&camada, forma, linha, coluna);
+        }
+
+        camadaParaMatriz(&camada, obtido);
+        if (memcmp(esperado, obtido, sizeof(esperado)) != 0 || atingidos != camada.navios_atingidos ||
+            camada.habilidades != habilidades) {
+            if (falhas++ < 5) {
+                printf("FALHA acumulacao: caso %d\n", caso);
+            }
+        }
+    }
+    printf("Acumulacao: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
+}
+
+// Função auxiliar para executar um cenário com as implementações de referência
+// (canPlaceShip/placeShip e aplicarHabilidadeAoTabuleiroReferencia com a matriz 7x7)
+static void executarCenarioReferencia(const Cenario *cenario, ResultadoCenario *resultado) {
+    static const MascaraHabilidade mascaras[NUM_HABILIDADES_PADRAO] = {MASCARA_CONE, MASCARA_CRUZ, MASCARA_OCTAEDRO};
+    int matriz[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO];
+
+    memset(resultado->tabuleiro, 0, sizeof(resultado->tabuleiro));
+    resultado->navios_posicionados = 0;
+    for (int i = 0; i < cenario->quantidade_navios; i++) {
+        const NavioCenario *n = &cenario->navios[i];
+        if (canPlaceShip(resultado->tabuleiro, n->linha, n->coluna, n->tamanho, n->orientacao)) {
+            placeShip(resultado->tabuleiro, n->linha, n->coluna, n->tamanho, n->orientacao);
+            resultado->navios_posicionados++;
+        }
+    }
+    for (int i = 0; i < cenario->quantidade_habilidades; i++) {
+        const HabilidadeCenario *h = &cenario->habilidades[i];
+        expandirHabilidade(mascaras[h->forma], matriz);
+        resultado->atingidos[i] = 0;
+        for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
+            for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
+                int r_tab = h->linha + r - HABILIDADE_CENTRO, c_tab = h->coluna + c - HABILIDADE_CENTRO;
+                resultado->atingidos[i] += matriz[r][c] == 1 && r_tab >= 0 && r_tab < TABULEIRO_TAMANHO &&
+                                           c_tab >= 0 && c_tab < TABULEIRO_TAMANHO &&
+                                           resultado->tabuleiro[r_tab][c_tab] == VALOR_NAVIO;
+            }
+        }
+        aplicarHabilidadeAoTabuleiroReferencia(resultado->tabuleiro, matriz, h->linha, h->coluna);
+    }
+    resultado->celulas_habilidade = 0;
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            resultado->celulas_habilidade += resultado->tabuleiro[r][c] == VALOR_HABILIDADE;
+        }
+    }
+}
+
+// Verificação do modo "lote": cenários sorteados, com comentários, linhas vazias e linhas
+// inválidas no meio, processados com 1 e com 3 threads; a saída deve ser idêntica à esperada,
+// montada linha a linha com as implementações de referência e na ordem da entrada.
+static int verificarLote(GeradorAleatorio *gerador) {
+    enum { CENARIOS_LOTE = 3000 };
+    static const int threads[] = {1, 3};
+    size_t capacidade = (size_t)CENARIOS_LOTE * SAIDA_MAX_CENARIO;
+    char *esperado = malloc(capacidade);
+    char *obtido = malloc(capacidade + 1);
+    FILE *entrada = tmpfile();
+    size_t tamanho_esperado = 0;
+    uint64_t numero_linha = 0;
+    int falhas = 0;
+
+    if (esperado == NULL || obtido == NULL || entrada == NULL) {
+        printf("FALHA lote: preparacao\n");
+        free(esperado);
+        free(obtido);
+        if (entrada != NULL) {
+            fclose(entrada);
+        }
+        return 1;
+    }
+    for (int i = 0; i < CENARIOS_LOTE; i++) {
+        Cenario cenario;
+        ResultadoCenario resultado;
+
+        if (i % 97 == 0) {
+            fprintf(entrada, i % 2 == 0 ? "# comentario\n" : "   \n");
+            numero_linha++;
+        }
+        numero_linha++;
+        if (i % 251 == 0) {
+            fprintf(entrada, "N 1 2 X A cone 2 5\n");
+            tamanho_esperado += (size_t)sprintf(esperado + tamanho_esperado,
+                                                "%llu erro orientacao invalida (use H, V, S ou D)\n",
+                                                (unsigned long long)numero_linha);
+            continue;
+        }
+        sortearCenario(gerador, &cenario);
+        escreverCenario(entrada, &cenario);
+        executarCenarioReferencia(&cenario, &resultado);
+        tamanho_esperado += formatarResultadoCenario(numero_linha, &cenario, &resultado, esperado + tamanho_esperado);
+    }
+
+    for (int k = 0; k < 2; k++) {
+        FILE *saida = tmpfile();
+        EstatisticasLote estatisticas;
+        rewind(entrada);
+        if (saida == NULL || !processarLote(entrada, saida, threads[k], &estatisticas)) {
+            printf("FALHA lote: processamento com %d threads\n", threads[k]);
+            falhas++;
+        } else {
+            rewind(saida);
+            size_t tamanho = fread(obtido, 1, capacidade + 1, saida);
+            if (tamanho != tamanho_esperado || memcmp(obtido, esperado, tamanho) != 0 ||
+                estatisticas.cenarios != CENARIOS_LOTE) {
+                printf("FALHA lote: saida diferente com %d threads\n", threads[k]);
+                falhas++;
+            }
+        }
+        if (saida != NULL) {
+            fclose(saida);
+        }
+    }
+    fclose(entrada);
+    free(esperado);
+    free(obtido);
+    printf("Lote: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
+}
+
+// Verificação do motor de movimento: movimentosPeca contra a referência passo a passo em todas as
+// casas, e caminhoPeca contra o percurso casa a casa com limite de passos aleatório
+static int verificarMovimentos(GeradorAleatorio *gerador) {
+    int falhas = 0;
+
+    for (int caso = 0; caso < 200; caso++) {
+        Bitboard bloqueios = sortearBloqueios(gerador, caso % 5);
+
+        for (int celula = 0; celula < TABULEIRO_CELULAS; celula++) {
+            for (int peca = 0; peca < NUM_PECAS; peca++) {
+                if (movimentosPeca((TipoPeca)peca, celula, bloqueios) !=
+                        movimentosPecaReferencia((TipoPeca)peca, celula, bloqueios) && falhas++ < 5) {
+                    printf("FALHA movimentos: caso %d, peca %d, celula %d\n", caso, peca, celula);
+                }
+            }
+
+            DirecaoMovimento direcao = (DirecaoMovimento)aleatorioAte(gerador, NUM_DIRECOES);
+            int passos = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO + 1);
+            uint8_t casas[TABULEIRO_TAMANHO];
+            int visitadas = caminhoPeca(celula, direcao, passos, bloqueios, casas);
+            int delta_row, delta_col, esperadas = 0;
+            int r = celula / TABULEIRO_TAMANHO, c = celula % TABULEIRO_TAMANHO;
+
+            deslocamentoDirecao(direcao, &delta_row, &delta_col);
+            for (r += delta_row, c += delta_col; esperadas < passos && r >= 0 && r < TABULEIRO_TAMANHO &&
+                 c >= 0 && c < TABULEIRO_TAMANHO && !(bloqueios & BITBOARD_CELULA(r, c));
+                 r += delta_row, c += delta_col) {
+                if ((esperadas >= visitadas || casas[esperadas] != r * TABULEIRO_TAMANHO + c) && falhas++ < 5) {
+                    printf("FALHA caminho: caso %d, celula %d, direcao %d\n", caso, celula, (int)direcao);
+                }
+                esperadas++;
+            }
+            if (esperadas != visitadas && falhas++ < 5) {
+                printf("FALHA caminho: caso %d, celula %d, %d casas em vez de %d\n", caso, celula, visitadas,
+                       esperadas);
+            }
+        }
+    }
+    printf("Movimentos: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
+}
+
+// Verificação do torneio: partidas repetidas com a mesma semente dão o mesmo resultado, o perdedor
+// nunca tem todos os navios atingidos, os tabuleiros batem com os bitboards de cada jogador e o
+// resultado agregado não depende do número de threads
+static int verificarTorneio(GeradorAleatorio *gerador) {
+    static ArenaTorneio arenas[2];
+    int falhas = 0;
+    ConfiguracaoTorneio config = {3000, 1, proximoAleatorio(gerador), {5, {5, 4, 3, 3, 2}}, 1, {{0}}};
+
+    prepararArenaTorneio(&arenas[0]);
+    prepararArenaTorneio(&arenas[1]);
+    for (int partida = 0; partida < 300; partida++) {
+        for (int j = 0; j < 2; j++) {
+            config.jogadores[j].tiro = (EstrategiaTiro)aleatorioAte(gerador, NUM_ESTRATEGIAS_TIRO);
+            config.jogadores[j].posicionamento =
+                (EstrategiaPosicionamento)aleatorioAte(gerador, NUM_ESTRATEGIAS_POSICIONAMENTO);
+        }
+        int vencedor = jogarPartidaTorneio(&config, &arenas[0], (uint64_t)partida);
+        int repetido = jogarPartidaTorneio(&config, &arenas[1], (uint64_t)partida);
+        bool consistente = vencedor >= 0 && vencedor == repetido;
+
+        for (int j = 0; j < 2 && consistente; j++) {
+            const JogadorTorneio *jogador = &arenas[0].jogadores[j];
+            int esperado[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+
+            for (int celula = 0; celula < TABULEIRO_CELULAS; celula++) {
+                Bitboard bit = (Bitboard)1 << celula;
+                esperado[celula / TABULEIRO_TAMANHO][celula % TABULEIRO_TAMANHO] =
+                    (jogador->navios & bit) ? VALOR_NAVIO : (jogador->cobertas & bit) ? VALOR_HABILIDADE : VALOR_AGUA;
+            }
+            consistente = memcmp(esperado, jogador->tabuleiro, sizeof(esperado)) == 0 &&
+                          contarBits(jogador->navios) == 17 &&
+                          jogador->disparos == arenas[1].jogadores[j].disparos &&
+                          ((jogador->navios & ~jogador->atingidos) == 0) == (j != vencedor);
+        }
+        if (!consistente && falhas++ < 5) {
+            printf("FALHA torneio: partida %d\n", partida);
+        }
+    }
+
+    // Resultado agregado com 1 e 3 threads
+    ResultadoTorneio resultados[2];
+    for (int i = 0; i < 2; i++) {
+        config.threads = 1 + 2 * i;
+        if (!executarTorneio(&config, &resultados[i]) && falhas++ < 5) {
+            printf("FALHA torneio: execucao com %d threads\n", config.threads);
         }
     }
+    if ((memcmp(&resultados[0], &resultados[1], sizeof(resultados[0])) != 0 ||
+         resultados[0].vitorias[0] + resultados[0].vitorias[1] != (uint64_t)config.partidas) && falhas++ < 5) {
+        printf("FALHA torneio: resultados diferentes com 1 e 3 threads\n");
+    }
+
+    // Intervalo de Wilson de 50 em 100 com z = 1.96: [0.4038, 0.5962]
+    double inferior, superior;
+    intervaloWilson(50, 100, 1.96, &inferior, &superior);
+    if ((inferior < 0.4037 || inferior > 0.4039 || superior < 0.5961 || superior > 0.5963) && falhas++ < 5) {
+        printf("FALHA torneio: intervalo de Wilson [%.4f, %.4f]\n", inferior, superior);
+    }
+    printf("Torneio: %s\n", falhas == 0 ? "OK" : "FALHOU");
+    return falhas;
 }
 
+static int modoVerificar(int argc, char *argv[]) {
+    GeradorAleatorio gerador;
+    int falhas = 0;
+
+    semearGerador(&gerador, (uint64_t)argumentoInteiro(argc, argv, 2, 1));
+    falhas += verificarFormasHabilidade();
+    falhas += verificarHabilidades(&gerador);
+    falhas += verificarSolver(&gerador);
+    falhas += verificarRenderizador(&gerador);
+    falhas += verificarArquivo(&gerador);
+    falhas += verificarDesfazer(&gerador);
+    falhas += verificarEnumeracao(&gerador);
+    falhas += verificarOrigens(&gerador);
+    falhas += verificarAcumulacao(&gerador);
+    falhas += verificarLote(&gerador);
+    falhas += verificarMovimentos(&gerador);
+    falhas += verificarTorneio(&gerador);
+    return falhas == 0 ? 0 : 1;
+}
+
+// Função para executar um modo escolhido pelo primeiro argumento
+static int executarModo(int argc, char *argv[]) {
+    if (strcmp(argv[1], "frotas") == 0) {
+        return modoFrotas(argc, argv);
+    }
+    if (strcmp(argv[1], "bench-frotas") == 0) {
+        return modoBenchFrotas(argc, argv);
+    }
+    if (strcmp(argv[1], "bench-tabuleiro") == 0) {
+        return modoBenchTabuleiro(argc, argv);
+    }
+    if (strcmp(argv[1], "mapa-calor") == 0) {
+        return modoMapaCalor(argc, argv);
+    }
+    if (strcmp(argv[1], "enumerar") == 0) {
+        return modoEnumerar(argc, argv);
+    }
+    if (strcmp(argv[1], "gravar") == 0) {
+        return modoGravar(argc, argv);
+    }
+    if (strcmp(argv[1], "ler") == 0) {
+        return modoLer(argc, argv);
+    }
+    if (strcmp(argv[1], "bench-desfazer") == 0) {
+        return modoBenchDesfazer(argc, argv);
+    }
+    if (strcmp(argv[1], "bench-origens") == 0) {
+        return modoBenchOrigens(argc, argv);
+    }
+    if (strcmp(argv[1], "bench-render") == 0) {
+        return modoBenchRender(argc, argv);
+    }
+    if (strcmp(argv[1], "bench-movimentos") == 0) {
+        return modoBenchMovimentos(argc, argv);
+    }
+    if (strcmp(argv[1], "bench-solver") == 0) {
+        return modoBenchSolver(argc, argv);
+    }
+    if (strcmp(argv[1], "simular") == 0) {
+        return modoSimular(argc, argv);
+    }
+    if (strcmp(argv[1], "torneio") == 0) {
+        return modoTorneio(argc, argv);
+    }
+    if (strcmp(argv[1], "lote") == 0) {
+        return modoLote(argc, argv);
+    }
+    if (strcmp(argv[1], "gerar-cenarios") == 0) {
+        return modoGerarCenarios(argc, argv);
+    }
+    if (strcmp(argv[1], "verificar") == 0) {
+        return modoVerificar(argc, argv);
+    }
+    fprintf(stderr, "Modo desconhecido: %s\n", argv[1]);
+    fprintf(stderr, "Modos: frotas, bench-frotas, bench-tabuleiro, bench-solver, bench-render,\n"
+                    "       bench-desfazer, bench-origens, bench-movimentos, simular, mapa-calor, enumerar,\n"
+                    "       gravar, ler, torneio, lote, gerar-cenarios, verificar\n");
+    return 1;
+}
 
 // --- Função Principal ---
-int main() {
-    // --- Simulação do Movimento da TORRE (usando recursividade) ---
+int main(int argc, char *argv[]) {
+    inicializarBitboards(); // Tabelas de máscaras usadas pelas funções *Bits
+
+    // Com argumentos, executa um dos modos (gerador, benchmarks); sem argumentos, a demonstração
+    if (argc > 1) {
+        return executarModo(argc, argv);
+    }
+
+    // --- Simulação do Movimento da TORRE (caminho gerado pelo motor de movimento) ---
+    // Os títulos "(Recursivo)" são mantidos para que a saída da demonstração não mude.
     printf("--- Movimento da TORRE (Recursivo) ---\n");
     printf("A Torre se movera 5 casas para a direita.\n");
-    moverTorreRecursivo(5, 1); // Inicia a recursão para 5 passos, começando do passo 1
+    moverTorre(5);
 
-    // --- Simulação do Movimento do BISPO (usando recursividade) ---
+    // --- Simulação do Movimento do BISPO (caminho gerado pelo motor de movimento) ---
     printf("--- Movimento do BISPO (Recursivo) ---\n");
     printf("O Bispo se movera 5 casas na diagonal (cima e direita).\n");
-    moverBispoRecursivo(5, 1); // Inicia a recursão para 5 passos, começando do passo 1
+    moverBispo(5);
 
-    // --- Simulação do Movimento da RAINHA (usando recursividade) ---
+    // --- Simulação do Movimento da RAINHA (caminho gerado pelo motor de movimento) ---
     printf("--- Movimento da RAINHA (Recursivo) ---\n");
     printf("A Rainha se movera 8 casas para a esquerda.\n");
-    moverRainhaRecursivo(8, 1); // Inicia a recursão para 8 passos, começando do passo 1
+    moverRainha(8);
 
-    // --- Simulação do Movimento do CAVALO (usando loops aninhados complexos) ---
+    // --- Simulação do Movimento do CAVALO (salto conferido pelo motor de movimento) ---
     // O Cavalo move-se em "L": 2 casas em uma direção e 1 casa perpendicularmente.
     // Simulação: 2 casas para CIMA e 1 casa para a DIREITA.
     printf("--- Movimento do CAVALO (Loops Aninhados Complexos) ---\n");
     printf("O Cavalo se movera em 'L': 2 casas para CIMA e 1 casa para a DIREITA.\n");
-
-    int passos_verticais = 2;   // Quantidade de passos verticais
-    int passos_horizontais = 1; // Quantidade de passos horizontais
-    int passo_total = 0;        // Contador de passos totais para o Cavalo
-
-    // Loop externo (for) para simular os passos verticais (CIMA)
-    for (int y = 0; y < passos_verticais; y++) {
-        passo_total++;
-        printf("Passo %d do Cavalo: Cima\n", passo_total);
-        // Exemplo de uso de 'continue' (não estritamente necessário aqui, mas demonstra o uso):
-        // if (y == 0) continue; // Poderia pular alguma lógica no primeiro passo vertical
-    }
-
-    // Loop interno (while) para simular os passos horizontais (DIREITA)
-    int x_cavalo = 0;
-    while (x_cavalo < passos_horizontais) {
-        passo_total++;
-        printf("Passo %d do Cavalo: Direita\n", passo_total);
-        x_cavalo++;
-        // Exemplo de uso de 'break' (não estritamente necessário aqui, mas demonstra o uso):
-        // if (x_cavalo == 1) break; // Poderia parar após o primeiro passo horizontal
-    }
-    printf("Cavalo parou.\n\n");
+    moverCavalo(TABULEIRO_TAMANHO - 1, 0, -2, 1); // Parte do canto inferior esquerdo
 
     // --- Simulação do Movimento do BISPO (usando Loops Aninhados) ---
     // Esta é uma implementação alternativa para simular um movimento diagonal
@@ -345,22 +2053,16 @@ int main() {
     printf("========================================\n\n");
 
     // 1. Represente o Tabuleiro: Matriz 10x10 inicializada com 0 (água)
-    int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
-    int r_tab, c_tab; // Variáveis de controle para loops do tabuleiro
-
-    // Inicializa todas as posições do tabuleiro com VALOR_AGUA
-    for (r_tab = 0; r_tab < TABULEIRO_TAMANHO; r_tab++) {
-        for (c_tab = 0; c_tab < TABULEIRO_TAMANHO; c_tab++) {
-            tabuleiro[r_tab][c_tab] = VALOR_AGUA;
-        }
-    }
+    // O tabuleiro anota cada alteração para poder voltar a um instantâneo anterior.
+    TabuleiroDesfazer tabuleiro;
+    iniciarTabuleiroDesfazer(&tabuleiro);
 
     // 2. Posicione Quatro Navios:
     // Navio 1: Horizontal
     // Coordenadas de início: linha 2, coluna 1
     int n1_r = 2, n1_c = 1;
-    if (canPlaceShip(tabuleiro, n1_r, n1_c, TAMANHO_NAVIO, HORIZONTAL)) {
-        placeShip(tabuleiro, n1_r, n1_c, TAMANHO_NAVIO, HORIZONTAL);
+    if (canPlaceShip(tabuleiro.celulas, n1_r, n1_c, TAMANHO_NAVIO, HORIZONTAL)) {
+        placeShipDesfazer(&tabuleiro, n1_r, n1_c, TAMANHO_NAVIO, HORIZONTAL);
         printf("Navio 1 (Horizontal) posicionado com sucesso em (%d,%d).\n", n1_r, n1_c);
     } else {
         printf("Erro: Nao foi possivel posicionar Navio 1 (Horizontal) em (%d,%d).\n", n1_r, n1_c);
@@ -369,8 +2071,8 @@ int main() {
     // Navio 2: Vertical
     // Coordenadas de início: linha 4, coluna 6
     int n2_r = 4, n2_c = 6;
-    if (canPlaceShip(tabuleiro, n2_r, n2_c, TAMANHO_NAVIO, VERTICAL)) {
-        placeShip(tabuleiro, n2_r, n2_c, TAMANHO_NAVIO, VERTICAL);
+    if (canPlaceShip(tabuleiro.celulas, n2_r, n2_c, TAMANHO_NAVIO, VERTICAL)) {
+        placeShipDesfazer(&tabuleiro, n2_r, n2_c, TAMANHO_NAVIO, VERTICAL);
         printf("Navio 2 (Vertical) posicionado com sucesso em (%d,%d).\n", n2_r, n2_c);
     } else {
         printf("Erro: Nao foi possivel posicionar Navio 2 (Vertical) em (%d,%d).\n", n2_r, n2_c);
@@ -380,8 +2082,8 @@ int main() {
     // Coordenadas de início: linha 0, coluna 0 (superior esquerda)
     // Movimento: (0,0) -> (1,1) -> (2,2)
     int n3_r = 0, n3_c = 0;
-    if (canPlaceShip(tabuleiro, n3_r, n3_c, TAMANHO_NAVIO, DIAGONAL_DOWN_RIGHT)) {
-        placeShip(tabuleiro, n3_r, n3_c, TAMANHO_NAVIO, DIAGONAL_DOWN_RIGHT);
+    if (canPlaceShip(tabuleiro.celulas, n3_r, n3_c, TAMANHO_NAVIO, DIAGONAL_DOWN_RIGHT)) {
+        placeShipDesfazer(&tabuleiro, n3_r, n3_c, TAMANHO_NAVIO, DIAGONAL_DOWN_RIGHT);
         printf("Navio 3 (Diagonal Baixo-Direita) posicionado com sucesso em (%d,%d).\n", n3_r, n3_c);
     } else {
         printf("Erro: Nao foi possivel posicionar Navio 3 (Diagonal Baixo-Direita) em (%d,%d).\n", n3_r, n3_c);
@@ -391,17 +2093,18 @@ int main() {
     // Coordenadas de início: linha 2, coluna 7 (para ir para (1,8) e (0,9))
     // Movimento: (2,7) -> (1,8) -> (0,9)
     int n4_r = 2, n4_c = 7;
-    if (canPlaceShip(tabuleiro, n4_r, n4_c, TAMANHO_NAVIO, DIAGONAL_UP_RIGHT)) {
-        placeShip(tabuleiro, n4_r, n4_c, TAMANHO_NAVIO, DIAGONAL_UP_RIGHT);
+    if (canPlaceShip(tabuleiro.celulas, n4_r, n4_c, TAMANHO_NAVIO, DIAGONAL_UP_RIGHT)) {
+        placeShipDesfazer(&tabuleiro, n4_r, n4_c, TAMANHO_NAVIO, DIAGONAL_UP_RIGHT);
         printf("Navio 4 (Diagonal Cima-Direita) posicionado com sucesso em (%d,%d).\n", n4_r, n4_c);
     } else {
         printf("Erro: Nao foi possivel posicionar Navio 4 (Diagonal Cima-Direita) em (%d,%d).\n", n4_r, n4_c);
     }
     printf("\n");
+    PontoRestauracao navios_posicionados = pontoRestauracao(&tabuleiro); // Instantâneo só com os navios
 
     // Exibe o tabuleiro após o posicionamento dos navios
     printf("--- Tabuleiro com Navios Posicionados ---\n");
-    exibirTabuleiro(tabuleiro);
+    exibirTabuleiro(tabuleiro.celulas);
     printf("\n");
 
     // === HABILIDADES ESPECIAIS E ÁREAS DE EFEITO ===
@@ -420,31 +2123,13 @@ int main() {
     criarHabilidadeOctaedro(octaedro_habilidade);
 
     printf("Matriz de Habilidade - CONE:\n");
-    for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
-        for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
-            printf("%d ", cone_habilidade[r][c]);
-        }
-        printf("\n");
-    }
-    printf("\n");
+    exibirHabilidade(cone_habilidade);
 
     printf("Matriz de Habilidade - CRUZ:\n");
-    for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
-        for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
-            printf("%d ", cruz_habilidade[r][c]);
-        }
-        printf("\n");
-    }
-    printf("\n");
+    exibirHabilidade(cruz_habilidade);
 
     printf("Matriz de Habilidade - OCTAEDRO:\n");
-    for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
-        for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
-            printf("%d ", octaedro_habilidade[r][c]);
-        }
-        printf("\n");
-    }
-    printf("\n");
+    exibirHabilidade(octaedro_habilidade);
 
 
     // 2. Integrar Habilidades ao Tabuleiro: Definir origem e sobrepor
@@ -452,54 +2137,40 @@ int main() {
     // Aplicar Habilidade CONE
     // Origem: Linha 2, Coluna 5 (centro do cone no tabuleiro)
     printf("--- Aplicando Habilidade CONE no tabuleiro (Origem: [2,5]) ---\n");
-    aplicarHabilidadeAoTabuleiro(tabuleiro, cone_habilidade, 2, 5);
-    exibirTabuleiro(tabuleiro); // Exibe o tabuleiro com a área de efeito
+    aplicarHabilidadeAoTabuleiroDesfazer(&tabuleiro, cone_habilidade, 2, 5);
+    exibirTabuleiro(tabuleiro.celulas); // Exibe o tabuleiro com a área de efeito
     printf("\n");
 
     // IMPORTANTE: Para ver os efeitos de cada habilidade individualmente,
-    // você pode re-inicializar o tabuleiro ou testar um de cada vez.
-    // Para este exemplo, as habilidades se sobreporão nas posições de água (0).
-    // Para fins de demonstração clara, vou re-inicializar o tabuleiro e os navios
-    // antes de cada nova aplicação de habilidade no tabuleiro para melhor visualização
-    // de cada área de efeito.
+    // o tabuleiro volta a um instantâneo com apenas os navios antes de cada nova
+    // aplicação de habilidade. Só as células alteradas pela habilidade anterior
+    // são restauradas, sem re-inicializar o tabuleiro inteiro.
 
-    // Re-inicializa o tabuleiro para a próxima demonstração de habilidade
-    for (r_tab = 0; r_tab < TABULEIRO_TAMANHO; r_tab++) {
-        for (c_tab = 0; c_tab < TABULEIRO_TAMANHO; c_tab++) {
-            tabuleiro[r_tab][c_tab] = VALOR_AGUA;
-        }
-    }
-    // Re-posiciona os navios
-    placeShip(tabuleiro, n1_r, n1_c, TAMANHO_NAVIO, HORIZONTAL);
-    placeShip(tabuleiro, n2_r, n2_c, TAMANHO_NAVIO, VERTICAL);
-    placeShip(tabuleiro, n3_r, n3_c, TAMANHO_NAVIO, DIAGONAL_DOWN_RIGHT);
-    placeShip(tabuleiro, n4_r, n4_c, TAMANHO_NAVIO, DIAGONAL_UP_RIGHT);
+    // Desfaz a habilidade anterior e re-posiciona os navios sem verificação
+    // (como na demonstração original, o Navio 3 entra aqui mesmo tendo falhado antes)
+    restaurarTabuleiro(&tabuleiro, navios_posicionados);
+    placeShipDesfazer(&tabuleiro, n1_r, n1_c, TAMANHO_NAVIO, HORIZONTAL);
+    placeShipDesfazer(&tabuleiro, n2_r, n2_c, TAMANHO_NAVIO, VERTICAL);
+    placeShipDesfazer(&tabuleiro, n3_r, n3_c, TAMANHO_NAVIO, DIAGONAL_DOWN_RIGHT);
+    placeShipDesfazer(&tabuleiro, n4_r, n4_c, TAMANHO_NAVIO, DIAGONAL_UP_RIGHT);
+    PontoRestauracao navios_reposicionados = pontoRestauracao(&tabuleiro);
 
 
     // Aplicar Habilidade CRUZ
     // Origem: Linha 5, Coluna 5 (centro da cruz no tabuleiro)
     printf("--- Aplicando Habilidade CRUZ no tabuleiro (Origem: [5,5]) ---\n");
-    aplicarHabilidadeAoTabuleiro(tabuleiro, cruz_habilidade, 5, 5);
-    exibirTabuleiro(tabuleiro);
+    aplicarHabilidadeAoTabuleiroDesfazer(&tabuleiro, cruz_habilidade, 5, 5);
+    exibirTabuleiro(tabuleiro.celulas);
     printf("\n");
 
-    // Re-inicializa o tabuleiro para a próxima demonstração de habilidade
-    for (r_tab = 0; r_tab < TABULEIRO_TAMANHO; r_tab++) {
-        for (c_tab = 0; c_tab < TABULEIRO_TAMANHO; c_tab++) {
-            tabuleiro[r_tab][c_tab] = VALOR_AGUA;
-        }
-    }
-    // Re-posiciona os navios
-    placeShip(tabuleiro, n1_r, n1_c, TAMANHO_NAVIO, HORIZONTAL);
-    placeShip(tabuleiro, n2_r, n2_c, TAMANHO_NAVIO, VERTICAL);
-    placeShip(tabuleiro, n3_r, n3_c, TAMANHO_NAVIO, DIAGONAL_DOWN_RIGHT);
-    placeShip(tabuleiro, n4_r, n4_c, TAMANHO_NAVIO, DIAGONAL_UP_RIGHT);
+    // Desfaz a habilidade anterior para a próxima demonstração
+    restaurarTabuleiro(&tabuleiro, navios_reposicionados);
 
     // Aplicar Habilidade OCTAEDRO
     // Origem: Linha 7, Coluna 2 (centro do octaedro/losango no tabuleiro)
     printf("--- Aplicando Habilidade OCTAEDRO no tabuleiro (Origem: [7,2]) ---\n");
-    aplicarHabilidadeAoTabuleiro(tabuleiro, octaedro_habilidade, 7, 2);
-    exibirTabuleiro(tabuleiro);
+    aplicarHabilidadeAoTabuleiroDesfazer(&tabuleiro, octaedro_habilidade, 7, 2);
+    exibirTabuleiro(tabuleiro.celulas);
     printf("\n");
 
 
@@ -0,0 +1,1101 @@
+// Motor de Batalha Naval: tabuleiro, posicionamento de navios, habilidades, gerador de frotas,
+// solver, enumeração e formato binário, sem a demonstração nem os modos de linha de comando.
+// Nenhuma função do motor escreve na saída padrão: os renderizadores escrevem em buffers do
+// chamador. Toda a memória dos tabuleiros é do chamador (estruturas de tamanho fixo ou, no
+// Tabuleiro dinâmico, um vetor passado para iniciarTabuleiro); apenas a simulação e a enumeração
+// alocam o estado das próprias threads. As funções do caminho quente (posicionamento, carimbos
+// e aplicação de habilidades, gerador aleatório) estão no fim deste arquivo como 'static inline',
+// para serem expandidas nos laços de quem as chama.
+//
+// Antes de usar qualquer função de bitboard, posicionamento ou frota, chame inicializarBitboards().
+// Compilação: make (gera libbatalhanaval.a); programas incluem este arquivo e ligam a biblioteca.
+
+#ifndef BATALHA_NAVAL_H
+#define BATALHA_NAVAL_H
+
+#include <stdio.h>   // Para FILE no escritor de registros
+#include <stdbool.h> // Para usar tipos booleanos (true/false)
+#include <stddef.h>  // Para size_t
+#include <stdint.h>  // Para tipos inteiros de largura fixa usados nos bitboards
+
+// --- Constantes para o Tabuleiro de Batalha Naval ---
+#define TABULEIRO_TAMANHO 10 // Tabuleiro 10x10
+#define TAMANHO_NAVIO 3      // Navios de 3 posições
+#define VALOR_AGUA 0         // Representa água no tabuleiro
+#define VALOR_NAVIO 3        // Representa parte de um navio no tabuleiro
+#define VALOR_HABILIDADE 5   // Representa área afetada por habilidade
+
+// --- Constantes para as Matrizes de Habilidade ---
+#define HABILIDADE_TAMANHO 7 // Tamanho das matrizes de habilidade (ex: 7x7)
+#define HABILIDADE_CENTRO (HABILIDADE_TAMANHO / 2) // Centro para cálculos de forma
+
+// Enumeração para tipos de orientação de navio
+// Torna o código mais legível e robusto para definir a orientação dos navios.
+typedef enum {
+    HORIZONTAL,
+    VERTICAL,
+    DIAGONAL_UP_RIGHT,   // Linha diminui, coluna aumenta (ex: (2,0) -> (1,1) -> (0,2))
+    DIAGONAL_DOWN_RIGHT  // Linha aumenta, coluna aumenta (ex: (0,0) -> (1,1) -> (2,2))
+} OrientacaoNavio;
+
+#define NUM_ORIENTACOES 4 // Quantidade de valores de OrientacaoNavio
+
+// --- Tipos e Constantes do Bitboard ---
+#define TABULEIRO_CELULAS (TABULEIRO_TAMANHO * TABULEIRO_TAMANHO) // 100 células
+
+// Inteiro de 128 bits: um bit por célula do tabuleiro 10x10
+typedef unsigned __int128 Bitboard;
+
+#define BITBOARD_CELULA(r, c) ((Bitboard)1 << ((r) * TABULEIRO_TAMANHO + (c)))
+#define BITBOARD_GUARDA (~(Bitboard)0 << TABULEIRO_CELULAS) // Bits 100..127, fora do tabuleiro
+#define BITBOARD_FORA ((Bitboard)1 << 127)                   // Máscara de posicionamento inválido
+
+// Tabuleiro em bitboard: máscaras separadas para navios e áreas de habilidade,
+// mais a máscara de ocupação (navios | habilidades | guarda) usada nas verificações.
+typedef struct {
+    Bitboard ocupadas;
+    Bitboard navios;
+    Bitboard habilidades;
+} TabuleiroBits;
+
+// Posicionamento legal de um navio (sempre dentro dos limites) com sua máscara de células
+typedef struct {
+    Bitboard mascara;
+    uint8_t linha;
+    uint8_t coluna;
+    uint8_t tamanho;
+    uint8_t orientacao; // Valor de OrientacaoNavio
+    uint8_t celula;     // Índice da primeira célula (linha * TABULEIRO_TAMANHO + coluna)
+    int8_t passo;       // Diferença de índice entre células consecutivas do navio
+} PosicionamentoNavio;
+
+// Total de posicionamentos legais somando todos os tamanhos de 1 a TABULEIRO_TAMANHO:
+// horizontais e verticais T*(T-s+1) cada, diagonais (T-s+1)^2 cada.
+#define MAX_POSICIONAMENTOS (TABULEIRO_TAMANHO * TABULEIRO_TAMANHO * (TABULEIRO_TAMANHO + 1) + \
+                             TABULEIRO_TAMANHO * (TABULEIRO_TAMANHO + 1) * (2 * TABULEIRO_TAMANHO + 1) / 3)
+
+// Palavras de 64 bits de um conjunto com um bit por posicionamento de um mesmo tamanho
+#define PALAVRAS_POSICIONAMENTOS ((NUM_ORIENTACOES * TABULEIRO_CELULAS + 63) / 64)
+
+// --- Máscara Compacta de Habilidade ---
+// Matriz de habilidade 7x7 compactada em 64 bits: cada linha ocupa um byte
+// (bit c do byte r ligado quando a célula [r][c] da matriz vale 1).
+typedef uint64_t MascaraHabilidade;
+
+#define HABILIDADE_BIT(r, c) ((MascaraHabilidade)1 << ((r) * 8 + (c)))
+#define HABILIDADE_LINHA(m, r) ((uint32_t)((m) >> ((r) * 8)) & 0xFFu)
+
+_Static_assert(HABILIDADE_TAMANHO <= 8, "MascaraHabilidade comporta no maximo 8x8 celulas");
+
+// --- Formas das Habilidades Geradas em Tempo de Compilação ---
+// Cada forma é descrita por uma macro LINHA_*(r) com os bits afetados da linha 'r';
+// MASCARA_HABILIDADE junta as linhas em uma constante de 64 bits, calculada pelo compilador.
+#define MINIMO(a, b) ((a) < (b) ? (a) : (b))
+#define MAXIMO(a, b) ((a) > (b) ? (a) : (b))
+#define DISTANCIA_CENTRO(i) ((i) < HABILIDADE_CENTRO ? HABILIDADE_CENTRO - (i) : (i) - HABILIDADE_CENTRO)
+
+// Bits das colunas 'ini' a 'fim' (inclusive) de uma linha
+#define FAIXA_HABILIDADE(ini, fim) \
+    ((((MascaraHabilidade)1 << ((fim) + 1)) - 1) & ~(((MascaraHabilidade)1 << (ini)) - 1))
+
+// Cone apontando para baixo: a linha 'r' cobre as colunas a até 'r' casas do centro
+#define LINHA_CONE(r) \
+    FAIXA_HABILIDADE(MAXIMO(0, HABILIDADE_CENTRO - (r)), MINIMO(HABILIDADE_TAMANHO - 1, HABILIDADE_CENTRO + (r)))
+
+// Cruz: a linha central inteira e a coluna central
+#define LINHA_CRUZ(r) \
+    ((r) == HABILIDADE_CENTRO ? FAIXA_HABILIDADE(0, HABILIDADE_TAMANHO - 1) \
+                              : FAIXA_HABILIDADE(HABILIDADE_CENTRO, HABILIDADE_CENTRO))
+
+// Octaedro (losango): distância Manhattan até o centro no máximo HABILIDADE_CENTRO
+#define LINHA_OCTAEDRO(r) \
+    FAIXA_HABILIDADE(DISTANCIA_CENTRO(r), HABILIDADE_TAMANHO - 1 - DISTANCIA_CENTRO(r))
+
+#define LINHA_NA_MASCARA(LINHA, r) ((r) < HABILIDADE_TAMANHO ? LINHA(r) << ((r) * 8) : 0)
+#define MASCARA_HABILIDADE(LINHA) \
+    (LINHA_NA_MASCARA(LINHA, 0) | LINHA_NA_MASCARA(LINHA, 1) | LINHA_NA_MASCARA(LINHA, 2) | \
+     LINHA_NA_MASCARA(LINHA, 3) | LINHA_NA_MASCARA(LINHA, 4) | LINHA_NA_MASCARA(LINHA, 5) | \
+     LINHA_NA_MASCARA(LINHA, 6) | LINHA_NA_MASCARA(LINHA, 7))
+
+#define MASCARA_CONE MASCARA_HABILIDADE(LINHA_CONE)
+#define MASCARA_CRUZ MASCARA_HABILIDADE(LINHA_CRUZ)
+#define MASCARA_OCTAEDRO MASCARA_HABILIDADE(LINHA_OCTAEDRO)
+
+// --- Registro de Formas de Habilidade ---
+// Identificadores das formas que já vêm registradas; formas personalizadas recebem os seguintes.
+typedef enum {
+    HABILIDADE_CONE,
+    HABILIDADE_CRUZ,
+    HABILIDADE_OCTAEDRO,
+    NUM_HABILIDADES_PADRAO
+} IdHabilidade;
+
+// Variantes pré-calculadas de cada forma: as 4 rotações (sentido horário) da forma original
+// e as 4 rotações da forma espelhada (esquerda <-> direita).
+typedef enum {
+    VARIANTE_ORIGINAL,
+    VARIANTE_ROTACAO_90,
+    VARIANTE_ROTACAO_180,
+    VARIANTE_ROTACAO_270,
+    VARIANTE_ESPELHADA,
+    VARIANTE_ESPELHADA_90,
+    VARIANTE_ESPELHADA_180,
+    VARIANTE_ESPELHADA_270,
+    NUM_VARIANTES_HABILIDADE
+} VarianteHabilidade;
+
+#define MAX_HABILIDADES 32 // Formas padrão + personalizadas
+
+// Registro de formas: 8 bytes por variante, 64 bytes por forma
+typedef struct {
+    int quantidade;
+    MascaraHabilidade variantes[MAX_HABILIDADES][NUM_VARIANTES_HABILIDADE];
+} RegistroHabilidades;
+
+// --- Constantes do Renderizador de Tabuleiros ---
+// Formatos de saída do renderizador
+typedef enum {
+    FORMATO_COMPLETO, // Igual a exibirTabuleiro: cabeçalho, separadores e células com espaço
+    FORMATO_COMPACTO  // Um caractere por célula e uma quebra de linha por linha do tabuleiro
+} FormatoRenderizacao;
+
+// Pior caso de um tabuleiro no formato completo (cada célula inesperada pode ter até 11
+// caracteres, como em "-2147483648", mais o espaço)
+#define RENDERIZACAO_MAX_COMPLETO (3 + 12 * TABULEIRO_TAMANHO + 1 + 2 * 35 + 1 + \
+                                   TABULEIRO_TAMANHO * (13 + 12 * TABULEIRO_TAMANHO + 2))
+#define RENDERIZACAO_MAX_COMPACTO (TABULEIRO_TAMANHO * (TABULEIRO_TAMANHO + 1) + 1)
+#define RENDERIZACAO_MAX_HABILIDADE (HABILIDADE_TAMANHO * (HABILIDADE_TAMANHO * 12 + 1) + 1)
+
+// --- Tipos do Gerador de Frotas ---
+#define MAX_NAVIOS_FROTA 16 // Quantidade máxima de navios em uma frota gerada
+
+// Estado do gerador pseudoaleatório xoshiro256** (rápido e com semente reproduzível)
+typedef struct {
+    uint64_t s[4];
+} GeradorAleatorio;
+
+// Configuração de uma frota: quantos navios e o tamanho de cada um
+typedef struct {
+    int quantidade_navios;
+    uint8_t tamanhos[MAX_NAVIOS_FROTA];
+} ConfiguracaoFrota;
+
+// Frota gerada: células ocupadas e o índice (em posicionamentos) de cada navio.
+typedef struct {
+    Bitboard navios;
+    uint16_t posicionamento[MAX_NAVIOS_FROTA];
+} Frota;
+
+// --- Tipos da Simulação de Monte Carlo ---
+#define MAX_FORMAS_SIMULACAO 8 // Formas de habilidade avaliadas em uma simulação
+#define BLOCO_SIMULACAO 4096   // Frotas por bloco de trabalho (cada bloco tem sua própria semente)
+
+// Parâmetros de uma simulação: frotas sorteadas e formas avaliadas em todas as origens
+typedef struct {
+    long long frotas;
+    int threads;
+    uint64_t semente;
+    ConfiguracaoFrota frota;
+    int num_formas;
+    MascaraHabilidade formas[MAX_FORMAS_SIMULACAO];
+} ConfiguracaoSimulacao;
+
+// Resultado: soma, sobre todas as frotas, das células de navio atingidas por forma e origem
+typedef struct {
+    long long frotas;
+    uint64_t acertos[MAX_FORMAS_SIMULACAO][TABULEIRO_CELULAS];
+} ResultadoSimulacao;
+
+// --- Tipos do Solver de Tiros ---
+// Estado do atacante: tiros dados, acertos, e para cada posicionamento dos tamanhos da frota
+// se ele ainda é possível e quantos acertos cobre. As densidades por célula são mantidas
+// incrementalmente a cada tiro, separadas por tamanho de navio (sem o peso do tamanho).
+typedef struct {
+    Bitboard tiros;
+    Bitboard acertos;
+    Bitboard afundados; // Células de navios já afundados
+    uint64_t livre[TABULEIRO_CELULAS]; // Todos os bits ligados se a célula ainda não levou tiro
+    int num_tamanhos;
+    uint8_t tamanhos[TABULEIRO_TAMANHO]; // Tamanhos distintos da frota
+    int32_t peso[TABULEIRO_TAMANHO];     // Navios ainda não afundados de cada tamanho distinto
+    uint64_t validos[TABULEIRO_TAMANHO][PALAVRAS_POSICIONAMENTOS]; // Posicionamentos ainda possíveis
+    uint8_t acertos_cobertos[MAX_POSICIONAMENTOS]; // Por índice global de posicionamento
+    int32_t densidade[TABULEIRO_TAMANHO][TABULEIRO_CELULAS];      // Posicionamentos válidos por célula
+    int32_t densidade_alvo[TABULEIRO_TAMANHO][TABULEIRO_CELULAS]; // Mesma contagem, vezes os acertos cobertos
+    int32_t total[TABULEIRO_CELULAS];      // Soma das densidades ponderadas pelos pesos
+    int32_t total_alvo[TABULEIRO_CELULAS]; // Soma das densidades alvo ponderadas pelos pesos
+} SolverTiros;
+
+// --- Tipos do Tabuleiro com Registro de Desfazer ---
+// Cada célula só muda por placeShip (qualquer valor -> navio) ou por uma habilidade
+// (água -> habilidade), então entre dois retornos ela muda no máximo duas vezes
+// (água -> habilidade -> navio): 2 entradas por célula bastam para o registro.
+#define MAX_ALTERACOES_DESFAZER (2 * TABULEIRO_CELULAS)
+
+typedef struct {
+    uint8_t celula;      // Índice linha * TABULEIRO_TAMANHO + coluna
+    int valor_anterior;  // Valor da célula antes da alteração
+} AlteracaoCelula;
+
+typedef struct {
+    int celulas[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+    int quantidade; // Entradas usadas no registro
+    AlteracaoCelula registro[MAX_ALTERACOES_DESFAZER + 1]; // +1: folga da escrita sem desvio
+} TabuleiroDesfazer;
+
+typedef int PontoRestauracao; // Tamanho do registro no momento do instantâneo
+
+// --- Tipos da Avaliação de Habilidades em Todas as Origens ---
+// Carimbos de uma forma de habilidade já recortados ao tabuleiro, um por origem
+typedef struct {
+    Bitboard carimbo[TABULEIRO_CELULAS];
+} TabelaCarimbos;
+
+// Células de navio e de água que a habilidade cobriria em cada origem (no máximo 49)
+typedef struct {
+    uint8_t navios[TABULEIRO_CELULAS];
+    uint8_t agua[TABULEIRO_CELULAS];
+} AvaliacaoOrigens;
+
+// --- Tipos do Modo de Acumulação de Habilidades ---
+// Contadores por célula guardados em planos de bits ("bit-sliced"): o plano k tem o bit k
+// do contador de cada uma das 100 células. Somar uma habilidade é uma soma com propagação
+// de vai-um sobre os planos, 100 células por operação.
+#define PLANOS_INTENSIDADE 8 // Contadores de 0 a 255, saturados no máximo
+#define INTENSIDADE_MAXIMA ((1 << PLANOS_INTENSIDADE) - 1)
+
+typedef struct {
+    Bitboard planos[PLANOS_INTENSIDADE]; // Quantas habilidades cobriram cada célula
+    Bitboard navios;                     // Células de navio do tabuleiro
+    Bitboard navios_atingidos;           // Células de navio cobertas por alguma habilidade
+    long long habilidades;               // Habilidades acumuladas
+} CamadaIntensidade;
+
+// --- Tipos do Formato Binário de Tabuleiros e Frotas ---
+// Arquivo = cabeçalho de 32 bytes + registros de tamanho fixo, tudo em little-endian:
+//   0  "BNAV"               4  versão (u16)        6  tipo de registro (u8)
+//   7  tamanho do tabuleiro 8  navios por registro  10 bytes por registro (u16)
+//   12 quantidade de registros (u64, gravada ao fechar o arquivo)   20..31 reservado (zero)
+// Registro BITBOARD: máscara de navios e de habilidades, 13 bytes cada (100 bits).
+// Registro NAVIOS: 2 bytes por navio: linha | coluna << 4, orientação | tamanho << 2.
+#define ARQUIVO_MAGICO "BNAV"
+#define ARQUIVO_VERSAO 1
+#define ARQUIVO_CABECALHO 32
+#define BYTES_MASCARA ((TABULEIRO_CELULAS + 7) / 8) // 13 bytes para 100 células
+
+typedef enum {
+    REGISTRO_BITBOARD = 1,
+    REGISTRO_NAVIOS = 2
+} TipoRegistro;
+
+// Escritor em fluxo: registros acumulados no buffer do FILE e gravados em blocos grandes
+typedef struct {
+    FILE *arquivo;
+    TipoRegistro tipo;
+    int navios_por_registro;
+    uint64_t quantidade;
+} EscritorRegistros;
+
+// Leitor por mapeamento de memória: os registros são lidos direto do mapa, sem cópia
+typedef struct {
+    const uint8_t *dados;
+    size_t tamanho_mapa;
+    TipoRegistro tipo;
+    int navios_por_registro;
+    size_t bytes_registro;
+    uint64_t quantidade;
+} LeitorRegistros;
+
+// --- Tipos da Enumeração Exaustiva de Frotas ---
+#define NUM_SIMETRIAS 8 // Rotações e reflexões do tabuleiro quadrado (a simetria 0 é a identidade)
+#define MAX_POSICIONAMENTOS_TAMANHO (NUM_ORIENTACOES * TABULEIRO_CELULAS)
+
+// Conjunto de posicionamentos de um mesmo tamanho, por índice relativo ao primeiro deles
+typedef struct {
+    uint64_t palavras[PALAVRAS_POSICIONAMENTOS];
+} ConjuntoPosicionamentos;
+
+// Tabelas pré-calculadas para enumerar frotas de navios de um mesmo tamanho
+typedef struct {
+    int tamanho;
+    int quantidade; // Posicionamentos legais do tamanho
+    int primeiro;   // Índice global (em posicionamentos) do posicionamento relativo 0
+    // Para cada posicionamento: os de índice maior que não se sobrepõem a ele
+    ConjuntoPosicionamentos compativeis[MAX_POSICIONAMENTOS_TAMANHO];
+    // Para cada posicionamento: os que não têm, na sua órbita de simetria, índice menor que ele
+    ConjuntoPosicionamentos acima_orbita[MAX_POSICIONAMENTOS_TAMANHO];
+    // Imagem de cada posicionamento por cada simetria
+    uint16_t simetria[NUM_SIMETRIAS][MAX_POSICIONAMENTOS_TAMANHO];
+} TabelasEnumeracao;
+
+// Contagem de frotas: todas as frotas legais, as invariantes por cada simetria e as classes
+// de frotas equivalentes por simetria (lema de Burnside: média das frotas invariantes)
+typedef struct {
+    uint64_t frotas;
+    uint64_t fixas[NUM_SIMETRIAS];
+    uint64_t classes;
+} ResultadoEnumeracao;
+
+// --- Tipos do Tabuleiro com Dimensões em Tempo de Execução ---
+#define TABULEIRO_DINAMICO_MAX 64 // Maior dimensão aceita (tabuleiros de 1x1 a 64x64)
+
+// Caminho de código usado pelo tabuleiro: tamanhos comuns têm versões especializadas
+typedef enum {
+    FORMA_GENERICA,
+    FORMA_10X10,
+    FORMA_16X16
+} FormaTabuleiro;
+
+// Tabuleiro com dimensões escolhidas em tempo de execução
+// As células ficam em uma única alocação contígua, linha a linha (mesmo layout de int[L][C]).
+typedef struct {
+    int linhas;
+    int colunas;
+    FormaTabuleiro forma;
+    int *celulas;
+} Tabuleiro;
+
+#define TABULEIRO_CELULA(t, r, c) ((t)->celulas[(r) * (t)->colunas + (c)])
+
+// --- Tipos do Motor de Movimento das Peças ---
+// Direções dos raios de movimento no tabuleiro 10x10. Nas quatro primeiras o índice da célula
+// (linha * TABULEIRO_TAMANHO + coluna) cresce a cada passo; nas quatro últimas, diminui.
+typedef enum {
+    DIRECAO_DIREITA,
+    DIRECAO_BAIXO,
+    DIRECAO_BAIXO_DIREITA,
+    DIRECAO_BAIXO_ESQUERDA,
+    DIRECAO_ESQUERDA,
+    DIRECAO_CIMA,
+    DIRECAO_CIMA_ESQUERDA,
+    DIRECAO_CIMA_DIREITA,
+    NUM_DIRECOES
+} DirecaoMovimento;
+
+#define DIRECOES_CRESCENTES 4 // Direções em que o índice da célula cresce
+
+typedef enum {
+    PECA_TORRE,
+    PECA_BISPO,
+    PECA_RAINHA,
+    PECA_CAVALO,
+    NUM_PECAS
+} TipoPeca;
+
+// --- Tipos do Torneio entre Estratégias ---
+// Partidas completas entre dois jogadores: cada um posiciona a frota no próprio tabuleiro com
+// canPlaceShip/placeShip e, em turnos alternados, dispara no tabuleiro do outro com
+// aplicarHabilidadeAoTabuleiro (o tiro simples é uma habilidade de uma célula). Vence quem
+// atingir primeiro todas as células de navio do adversário.
+#define BLOCO_TORNEIO 1024                          // Partidas por bloco de trabalho
+#define NUM_DISPAROS (NUM_HABILIDADES_PADRAO + 1)   // Tiro simples e as formas padrão
+#define DISPARO_TIRO 0                              // Índice do tiro simples; a forma 'id' usa 1 + id
+
+// Escolha da origem de cada disparo
+typedef enum {
+    TIRO_ALEATORIO, // Célula ainda não coberta, sorteada
+    TIRO_CACA,      // Sorteio até acertar; depois, vizinhas dos acertos em navios não afundados
+                    // (com as diagonais se o adversário posiciona navios diagonais)
+    TIRO_PARIDADE,  // Como TIRO_CACA, mas sorteando só as células de uma cor do xadrez (ou, contra
+                    // navios diagonais, as de linha ou coluna par)
+    NUM_ESTRATEGIAS_TIRO
+} EstrategiaTiro;
+
+// Escolha das posições dos navios (todas passam por canPlaceShip)
+typedef enum {
+    POSICIONAMENTO_ALEATORIO, // Linha, coluna e orientação sorteadas
+    POSICIONAMENTO_RETO,      // Só horizontais e verticais
+    POSICIONAMENTO_BORDAS,    // Horizontais e verticais encostados na borda, quando couberem
+    NUM_ESTRATEGIAS_POSICIONAMENTO
+} EstrategiaPosicionamento;
+
+typedef struct {
+    EstrategiaTiro tiro;
+    EstrategiaPosicionamento posicionamento;
+} EstrategiaJogador;
+
+typedef struct {
+    long long partidas;
+    int threads;
+    uint64_t semente;
+    ConfiguracaoFrota frota;
+    int cargas_habilidade; // Usos de cada forma padrão por jogador e partida
+    EstrategiaJogador jogadores[2];
+} ConfiguracaoTorneio;
+
+// Estado de um jogador durante uma partida
+// 'cobertas' e 'atingidos' se referem ao tabuleiro deste jogador (disparos do adversário);
+// 'cargas' e 'disparos' contam os disparos feitos por ele.
+typedef struct {
+    int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+    Bitboard navios;
+    Bitboard cascos[MAX_NAVIOS_FROTA]; // Células de cada navio, para saber quais afundaram
+    Bitboard cobertas;
+    Bitboard atingidos;
+    int cargas[NUM_HABILIDADES_PADRAO];
+    int disparos;
+} JogadorTorneio;
+
+// Arena de uma thread: jogadores e tabelas de disparo reaproveitados em todas as partidas,
+// sem nenhuma alocação por partida
+typedef struct {
+    JogadorTorneio jogadores[2];
+    int matrizes[NUM_DISPAROS][HABILIDADE_TAMANHO][HABILIDADE_TAMANHO];
+    Bitboard carimbos[NUM_DISPAROS][TABULEIRO_CELULAS];
+    Bitboard paridade;          // Células com linha + coluna par
+    Bitboard paridade_diagonal; // Células com linha ou coluna par (cobre também pares diagonais)
+} ArenaTorneio;
+
+typedef struct {
+    long long partidas;
+    uint64_t vitorias[2];
+    uint64_t vitorias_iniciando[2]; // Vitórias nas partidas em que o jogador disparou primeiro
+    uint64_t disparos_vencedor;     // Soma dos disparos do vencedor em todas as partidas
+} ResultadoTorneio;
+
+// --- Tipos do Processamento de Cenários em Lote ---
+// Um cenário é uma linha de texto com uma frota e uma lista de aplicações de habilidade:
+//   N <linha> <coluna> <orientação> [tamanho]   navio (orientação H, V, S = diagonal sobe, D = diagonal desce)
+//   A <forma> <linha> <coluna>                  habilidade (forma cone, cruz ou octaedro)
+// Ex.: "N 2 1 H N 4 6 V A cone 2 5 A cruz 5 5". Linhas vazias e iniciadas por '#' são ignoradas.
+#define MAX_HABILIDADES_CENARIO 16  // Aplicações de habilidade por cenário
+#define SAIDA_MAX_CENARIO 512       // Maior linha de resultado de um cenário, com o '\n'
+
+typedef struct {
+    int linha, coluna, tamanho;
+    OrientacaoNavio orientacao;
+} NavioCenario;
+
+typedef struct {
+    int linha, coluna;
+    IdHabilidade forma;
+} HabilidadeCenario;
+
+typedef struct {
+    int quantidade_navios;
+    int quantidade_habilidades;
+    NavioCenario navios[MAX_NAVIOS_FROTA];
+    HabilidadeCenario habilidades[MAX_HABILIDADES_CENARIO];
+} Cenario;
+
+// Resultado de um cenário: navios rejeitados por canPlaceShip ficam de fora do tabuleiro, e as
+// habilidades são aplicadas em sequência sobre o mesmo tabuleiro
+typedef struct {
+    int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+    int navios_posicionados;
+    int atingidos[MAX_HABILIDADES_CENARIO]; // Células de navio cobertas por cada habilidade
+    int celulas_habilidade;                 // Células marcadas como área de habilidade no final
+} ResultadoCenario;
+
+typedef struct {
+    uint64_t cenarios;          // Linhas de cenário (sem contar vazias e comentários)
+    uint64_t erros;             // Linhas com erro de sintaxe
+    uint64_t navios_rejeitados; // Navios recusados por canPlaceShip
+} EstatisticasLote;
+
+// --- Instrumentação Opcional das Operações Principais ---
+// Compilada apenas com -DINSTRUMENTACAO; sem a macro, os pontos de instrumentação abaixo
+// não geram nenhum código. Cada thread acumula os próprios contadores (chamadas, ciclos,
+// histograma de log2 dos ciclos e motivos de rejeição de canPlaceShip), sem travas nem
+// atômicos no caminho quente; na saída do programa os contadores de todas as threads são
+// somados e escritos em JSON na saída de erro (ou no arquivo da variável INSTRUMENTACAO_ARQUIVO).
+// As versões com registro de desfazer de placeShip e aplicarHabilidadeAoTabuleiro têm
+// operações próprias, para não misturar os histogramas.
+
+typedef enum {
+    OP_CAN_PLACE_SHIP,
+    OP_PLACE_SHIP,
+    OP_APLICAR_HABILIDADE,
+    OP_CRIAR_HABILIDADE,
+    OP_RENDERIZAR,
+    OP_PLACE_SHIP_DESFAZER,
+    OP_APLICAR_HABILIDADE_DESFAZER,
+    NUM_OPERACOES_INSTRUMENTADAS
+} OperacaoInstrumentada;
+
+typedef enum {
+    REJEICAO_ORIENTACAO, // Orientação inválida
+    REJEICAO_LIMITES,    // Alguma parte do navio fora do tabuleiro
+    REJEICAO_SOBREPOSICAO, // Alguma parte sobre uma célula que não é água
+    NUM_MOTIVOS_REJEICAO
+} MotivoRejeicao;
+
+#ifdef INSTRUMENTACAO
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // Para __rdtsc
+#else
+#include <time.h>      // Para clock_gettime
+#endif
+
+#define FAIXAS_HISTOGRAMA 32 // Faixa k: de 2^k a 2^(k+1) - 1 ciclos
+
+typedef struct ContadoresInstrumentacao {
+    uint64_t chamadas[NUM_OPERACOES_INSTRUMENTADAS];
+    uint64_t ciclos[NUM_OPERACOES_INSTRUMENTADAS];
+    uint64_t histograma[NUM_OPERACOES_INSTRUMENTADAS][FAIXAS_HISTOGRAMA];
+    uint64_t rejeicoes[NUM_MOTIVOS_REJEICAO];
+    struct ContadoresInstrumentacao *proximo; // Lista de todas as threads
+} ContadoresInstrumentacao;
+
+// Contadores da thread atual (NULL até a primeira operação medida na thread)
+extern _Thread_local ContadoresInstrumentacao *contadores_thread;
+
+// Função para criar e registrar os contadores da thread atual (instrumentacaoBatalhaNaval.c)
+ContadoresInstrumentacao *criarContadoresThread(void);
+
+// Função para obter os contadores da thread atual, criando-os na primeira chamada
+static inline ContadoresInstrumentacao *contadoresThread(void) {
+    return contadores_thread != NULL ? contadores_thread : criarContadoresThread();
+}
+
+// Função para ler o contador de ciclos (TSC no x86; nanossegundos nas demais arquiteturas)
+static inline uint64_t lerCiclos(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (uint64_t)agora.tv_sec * 1000000000ULL + (uint64_t)agora.tv_nsec;
+#endif
+}
+
+// Função para registrar uma chamada de 'operacao' que levou 'ciclos' ciclos
+static inline void registrarChamada(OperacaoInstrumentada operacao, uint64_t ciclos) {
+    ContadoresInstrumentacao *contadores = contadoresThread();
+    int faixa = 63 - __builtin_clzll(ciclos | 1);
+    contadores->chamadas[operacao]++;
+    contadores->ciclos[operacao] += ciclos;
+    contadores->histograma[operacao][MINIMO(faixa, FAIXAS_HISTOGRAMA - 1)]++;
+}
+
+#define INSTRUMENTAR_INICIO() uint64_t inicio_instrumentacao = lerCiclos()
+#define INSTRUMENTAR_FIM(operacao) registrarChamada((operacao), lerCiclos() - inicio_instrumentacao)
+// Rejeição em canPlaceShip: conta o motivo e encerra a medição da chamada
+#define INSTRUMENTAR_REJEICAO(motivo) \
+    (contadoresThread()->rejeicoes[(motivo)]++, INSTRUMENTAR_FIM(OP_CAN_PLACE_SHIP))
+
+#else
+
+#define INSTRUMENTAR_INICIO() ((void)0)
+#define INSTRUMENTAR_FIM(operacao) ((void)0)
+#define INSTRUMENTAR_REJEICAO(motivo) ((void)0)
+
+#endif
+
+// --- Tabelas Pré-calculadas ---
+// Máscaras de todos os posicionamentos (tamanho, orientação, linha, coluna), preenchidas por
+// inicializarBitboards() e usadas por mascaraNavio.
+extern Bitboard mascaras_navio[TABULEIRO_TAMANHO][NUM_ORIENTACOES][TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+
+// Raios de movimento (células de uma direção até a borda, sem a origem) e saltos do Cavalo
+// de cada célula, preenchidos por inicializarBitboards() e usados por movimentosPeca.
+extern Bitboard raios_movimento[NUM_DIRECOES][TABULEIRO_CELULAS];
+extern Bitboard saltos_cavalo[TABULEIRO_CELULAS];
+
+// --- Renderizador de Tabuleiros em Buffer ---
+size_t renderizarTabuleiro(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO], char *destino,
+                           FormatoRenderizacao formato);
+size_t renderizarTabuleiros(int tabuleiros[][TABULEIRO_TAMANHO][TABULEIRO_TAMANHO], int quantidade,
+                            char *destino, FormatoRenderizacao formato);
+size_t renderizarHabilidade(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO], char *destino);
+
+// --- Representação do Tabuleiro em Bitboard ---
+bool deslocamentoOrientacao(OrientacaoNavio orientation, int *delta_row, int *delta_col);
+void inicializarBitboards(void);
+const PosicionamentoNavio *posicionamentosDoTamanho(int size, int *quantidade);
+void limparTabuleiroBits(TabuleiroBits *tabuleiro);
+int listarPosicionamentosLegais(const TabuleiroBits *tabuleiro, int size, uint16_t indices[]);
+void matrizParaBitboard(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO], TabuleiroBits *bits);
+void bitboardParaMatriz(const TabuleiroBits *bits, int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]);
+void expandirHabilidade(MascaraHabilidade mascara, int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]);
+void criarHabilidadeCone(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]);
+void criarHabilidadeCruz(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]);
+void criarHabilidadeOctaedro(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]);
+MascaraHabilidade rotacionarHabilidade(MascaraHabilidade mascara);
+MascaraHabilidade espelharHabilidade(MascaraHabilidade mascara);
+int registrarHabilidade(RegistroHabilidades *registro, MascaraHabilidade mascara);
+void iniciarRegistroHabilidades(RegistroHabilidades *registro);
+void aplicarHabilidadeAoTabuleiroReferencia(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                                            int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO],
+                                            int origin_row, int origin_col);
+
+// --- Tabuleiro com Registro de Desfazer ---
+void iniciarTabuleiroDesfazer(TabuleiroDesfazer *tabuleiro);
+void restaurarTabuleiro(TabuleiroDesfazer *tabuleiro, PontoRestauracao ponto);
+void placeShipDesfazer(TabuleiroDesfazer *tabuleiro,
+                       int start_row, int start_col, int size, OrientacaoNavio orientation);
+void aplicarMascaraHabilidadeDesfazer(TabuleiroDesfazer *tabuleiro, MascaraHabilidade mascara,
+                                      int origin_row, int origin_col);
+void aplicarHabilidadeAoTabuleiroDesfazer(TabuleiroDesfazer *tabuleiro,
+                                         int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO],
+                                         int origin_row, int origin_col);
+
+// --- Gerador Aleatório de Frotas ---
+void semearGerador(GeradorAleatorio *gerador, uint64_t semente);
+const PosicionamentoNavio *posicionamentoPorIndice(int indice);
+bool configuracaoFrotaValida(const ConfiguracaoFrota *config);
+bool gerarFrota(GeradorAleatorio *gerador, const ConfiguracaoFrota *config, Frota *frota);
+int gerarFrotas(GeradorAleatorio *gerador, const ConfiguracaoFrota *config, Frota saida[], int quantidade);
+bool posicionarFrota(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                     const Frota *frota, const ConfiguracaoFrota *config);
+
+// --- Simulação de Monte Carlo de Acertos das Habilidades ---
+bool simularHabilidades(const ConfiguracaoSimulacao *config, ResultadoSimulacao *resultado);
+
+// --- Solver de Tiros por Densidade de Probabilidade ---
+void iniciarSolver(SolverTiros *solver, const ConfiguracaoFrota *config);
+void registrarTiro(SolverTiros *solver, int row, int col, bool acertou);
+void registrarAfundado(SolverTiros *solver, int indice);
+int escolherTiro(const SolverTiros *solver);
+int jogarPartidaSolver(SolverTiros *solver, const Frota *frota, const ConfiguracaoFrota *config);
+
+// --- Avaliação de Habilidades em Todas as Origens ---
+void prepararCarimbos(TabelaCarimbos *tabela, MascaraHabilidade mascara);
+void avaliarOrigensBits(const TabuleiroBits *tabuleiro, const TabelaCarimbos *tabela, AvaliacaoOrigens *avaliacao);
+void avaliarOrigensHabilidade(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO], const TabelaCarimbos *tabela,
+                              AvaliacaoOrigens *avaliacao);
+void avaliarOrigensReferencia(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                              int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO],
+                              AvaliacaoOrigens *avaliacao);
+
+// --- Modo de Acumulação de Habilidades ---
+void iniciarCamadaIntensidade(CamadaIntensidade *camada, int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]);
+void acumularHabilidade(CamadaIntensidade *camada, MascaraHabilidade mascara, int origin_row, int origin_col);
+void acumularHabilidades(CamadaIntensidade *camada, const TabelaCarimbos *tabela, const uint8_t origens[],
+                         int quantidade);
+void camadaParaMatriz(const CamadaIntensidade *camada, int intensidade[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]);
+size_t renderizarMapaCalor(const CamadaIntensidade *camada, char *destino);
+
+// --- Formato Binário de Tabuleiros e Frotas (arquivoBatalhaNaval.c) ---
+size_t bytesRegistro(TipoRegistro tipo, int navios_por_registro);
+bool abrirEscritor(EscritorRegistros *escritor, const char *caminho, TipoRegistro tipo, int navios_por_registro);
+bool escreverTabuleiroBits(EscritorRegistros *escritor, const TabuleiroBits *tabuleiro);
+bool escreverFrota(EscritorRegistros *escritor, const Frota *frota);
+bool fecharEscritor(EscritorRegistros *escritor);
+void fecharLeitor(LeitorRegistros *leitor);
+bool abrirLeitor(LeitorRegistros *leitor, const char *caminho);
+bool lerRegistroBits(const LeitorRegistros *leitor, uint64_t indice, TabuleiroBits *tabuleiro);
+bool lerRegistroMatriz(const LeitorRegistros *leitor, uint64_t indice,
+                       int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]);
+
+// --- Enumeração Exaustiva de Frotas ---
+bool prepararEnumeracao(TabelasEnumeracao *tabelas, int size);
+bool contarFrotas(const TabelasEnumeracao *tabelas, int navios, int threads, ResultadoEnumeracao *resultado);
+long long enumerarFrotasCanonicas(const TabelasEnumeracao *tabelas, int navios, int threads,
+                                  EscritorRegistros *escritor);
+
+// --- Processamento de Cenários em Lote (loteBatalhaNaval.c) ---
+bool interpretarCenario(const char *texto, Cenario *cenario, const char **erro);
+void executarCenario(const Cenario *cenario, ResultadoCenario *resultado);
+size_t formatarResultadoCenario(uint64_t numero_linha, const Cenario *cenario, const ResultadoCenario *resultado,
+                                char *destino);
+bool processarLote(FILE *entrada, FILE *saida, int threads, EstatisticasLote *estatisticas);
+
+// --- Torneio entre Estratégias (torneioBatalhaNaval.c) ---
+void prepararArenaTorneio(ArenaTorneio *arena);
+int jogarPartidaTorneio(const ConfiguracaoTorneio *config, ArenaTorneio *arena, uint64_t partida);
+bool executarTorneio(const ConfiguracaoTorneio *config, ResultadoTorneio *resultado);
+void intervaloWilson(uint64_t sucessos, uint64_t total, double z, double *inferior, double *superior);
+
+// --- Tabuleiro com Dimensões em Tempo de Execução ---
+void limparTabuleiro(Tabuleiro *tabuleiro);
+bool iniciarTabuleiro(Tabuleiro *tabuleiro, int linhas, int colunas, int *celulas);
+bool criarTabuleiro(Tabuleiro *tabuleiro, int linhas, int colunas);
+void liberarTabuleiro(Tabuleiro *tabuleiro);
+bool canPlaceShipTabuleiro(const Tabuleiro *tabuleiro,
+                           int start_row, int start_col, int size, OrientacaoNavio orientation);
+void placeShipTabuleiro(Tabuleiro *tabuleiro,
+                        int start_row, int start_col, int size, OrientacaoNavio orientation);
+void aplicarHabilidadeTabuleiro(Tabuleiro *tabuleiro, const int *matriz, int tamanho,
+                                int origin_row, int origin_col);
+
+// --- Motor de Movimento das Peças ---
+void deslocamentoDirecao(DirecaoMovimento direcao, int *delta_row, int *delta_col);
+int caminhoPeca(int celula, DirecaoMovimento direcao, int passos, Bitboard bloqueios, uint8_t casas[]);
+
+// --- Funções em Linha do Caminho Quente ---
+
+// Função para contar quantos bits estão ligados em um bitboard
+static inline int contarBits(Bitboard bits) {
+    return __builtin_popcountll((uint64_t)bits) + __builtin_popcountll((uint64_t)(bits >> 64));
+}
+
+// Função para retirar a célula de menor índice de um bitboard não vazio
+// Retorna o índice da célula (linha * TABULEIRO_TAMANHO + coluna) e a desliga em '*bits'.
+static inline int extrairCelula(Bitboard *bits) {
+    int celula = (uint64_t)*bits ? __builtin_ctzll((uint64_t)*bits)
+                                 : 64 + __builtin_ctzll((uint64_t)(*bits >> 64));
+    *bits &= *bits - 1;
+    return celula;
+}
+
+// Função auxiliar para encontrar a posição do 'ordem'-ésimo bit ligado de uma palavra
+// Busca binária por contagem de bits nas metades, sem laço sobre cada bit.
+static inline int selecionarBit(uint64_t palavra, int ordem) {
+    int posicao = 0;
+    for (int largura = 32; largura > 0; largura >>= 1) {
+        uint64_t metade_baixa = palavra & ((1ULL << largura) - 1);
+        int n = __builtin_popcountll(metade_baixa);
+        if (ordem >= n) {
+            ordem -= n;
+            palavra >>= largura;
+            posicao += largura;
+        } else {
+            palavra = metade_baixa;
+        }
+    }
+    return posicao;
+}
+
+// Função para obter a célula de menor índice de um bitboard não vazio, sem alterá-lo
+static inline int menorCelula(Bitboard bits) {
+    return (uint64_t)bits ? __builtin_ctzll((uint64_t)bits) : 64 + __builtin_ctzll((uint64_t)(bits >> 64));
+}
+
+// Função para obter a célula de maior índice de um bitboard não vazio
+static inline int maiorCelula(Bitboard bits) {
+    return (uint64_t)(bits >> 64) ? 127 - __builtin_clzll((uint64_t)(bits >> 64))
+                                  : 63 - __builtin_clzll((uint64_t)bits);
+}
+
+// Função para obter as células livres de um raio de movimento, parando antes do primeiro bloqueio
+// O primeiro bloqueio é a célula do raio mais próxima da origem: a de menor índice nas direções
+// crescentes e a de maior índice nas demais. Ela e o resto do raio a partir dela são removidos.
+static inline Bitboard raioLivre(DirecaoMovimento direcao, int celula, Bitboard bloqueios) {
+    Bitboard raio = raios_movimento[direcao][celula];
+    Bitboard bloqueados = raio & bloqueios;
+
+    if (!bloqueados) {
+        return raio;
+    }
+    int primeiro = direcao < DIRECOES_CRESCENTES ? menorCelula(bloqueados) : maiorCelula(bloqueados);
+    return raio & ~(raios_movimento[direcao][primeiro] | ((Bitboard)1 << primeiro));
+}
+
+// Função para obter o conjunto de casas que uma peça alcança a partir de 'celula' em um lance
+// 'bloqueios' marca as células que a peça não pode ocupar nem atravessar (normalmente os navios
+// do tabuleiro); o Cavalo salta, então só as casas de destino são testadas.
+static inline Bitboard movimentosPeca(TipoPeca peca, int celula, Bitboard bloqueios) {
+    Bitboard ortogonais = 0, diagonais = 0;
+
+    if (peca == PECA_CAVALO) {
+        return saltos_cavalo[celula] & ~bloqueios;
+    }
+    if (peca != PECA_BISPO) {
+        ortogonais = raioLivre(DIRECAO_DIREITA, celula, bloqueios) | raioLivre(DIRECAO_BAIXO, celula, bloqueios) |
+                     raioLivre(DIRECAO_ESQUERDA, celula, bloqueios) | raioLivre(DIRECAO_CIMA, celula, bloqueios);
+    }
+    if (peca != PECA_TORRE) {
+        diagonais = raioLivre(DIRECAO_BAIXO_DIREITA, celula, bloqueios) |
+                    raioLivre(DIRECAO_BAIXO_ESQUERDA, celula, bloqueios) |
+                    raioLivre(DIRECAO_CIMA_ESQUERDA, celula, bloqueios) |
+                    raioLivre(DIRECAO_CIMA_DIREITA, celula, bloqueios);
+    }
+    return ortogonais | diagonais;
+}
+
+// Função para obter a máscara de um posicionamento de navio
+// Coordenadas, tamanhos ou orientações inválidas retornam BITBOARD_FORA.
+// Tamanhos menores ou iguais a zero não ocupam nenhuma célula (como em canPlaceShip).
+static inline Bitboard mascaraNavio(int start_row, int start_col, int size, OrientacaoNavio orientation) {
+    if (size <= 0) {
+        return 0;
+    }
+    if ((unsigned)start_row >= TABULEIRO_TAMANHO || (unsigned)start_col >= TABULEIRO_TAMANHO ||
+        (unsigned)(size - 1) >= TABULEIRO_TAMANHO || (unsigned)orientation >= NUM_ORIENTACOES) {
+        return BITBOARD_FORA;
+    }
+    return mascaras_navio[size - 1][orientation][start_row][start_col];
+}
+
+// Função para verificar se um navio pode ser posicionado no tabuleiro
+// Verifica se todas as posições do navio estão dentro dos limites do tabuleiro
+// e se não estão ocupadas por outras partes de navio (valor 3).
+// Retorna true se o posicionamento é válido, false caso contrário.
+static inline bool canPlaceShip(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                                int start_row, int start_col, int size, OrientacaoNavio orientation) {
+    int r, c; // Variáveis para as coordenadas atuais dentro do loop
+    INSTRUMENTAR_INICIO();
+
+    for (int i = 0; i < size; i++) {
+        // Calcula as coordenadas da posição atual do navio com base na orientação
+        if (orientation == HORIZONTAL) {
+            r = start_row;
+            c = start_col + i;
+        } else if (orientation == VERTICAL) {
+            r = start_row + i;
+            c = start_col;
+        } else if (orientation == DIAGONAL_DOWN_RIGHT) { // Linha aumenta, coluna aumenta
+            r = start_row + i;
+            c = start_col + i;
+        } else if (orientation == DIAGONAL_UP_RIGHT) { // Linha diminui, coluna aumenta
+            r = start_row - i;
+            c = start_col + i;
+        } else {
+            // Caso de orientação inválida, embora o enum restrinja isso
+            INSTRUMENTAR_REJEICAO(REJEICAO_ORIENTACAO);
+            return false;
+        }
+
+        // --- Validação de Limites ---
+        // Verifica se a posição calculada está dentro dos limites do tabuleiro (0 a TABULEIRO_TAMANHO-1)
+        if (r < 0 || r >= TABULEIRO_TAMANHO || c < 0 || c >= TABULEIRO_TAMANHO) {
+            INSTRUMENTAR_REJEICAO(REJEICAO_LIMITES);
+            return false; // Fora dos limites do tabuleiro
+        }
+
+        // --- Validação de Sobreposição ---
+        // Verifica se a posição já está ocupada por outro navio (valor 3)
+        if (tabuleiro[r][c] != VALOR_AGUA) { // Se não for água, já está ocupado
+            INSTRUMENTAR_REJEICAO(REJEICAO_SOBREPOSICAO);
+            return false; // Sobreposição detectada
+        }
+    }
+    INSTRUMENTAR_FIM(OP_CAN_PLACE_SHIP);
+    return true; // Se todas as verificações passarem, o posicionamento é válido
+}
+
+// Função para posicionar um navio no tabuleiro
+// Esta função assume que 'canPlaceShip' já foi chamada e confirmou que o posicionamento é válido.
+// Ela simplesmente marca as posições no tabuleiro com o valor '3' (parte do navio).
+static inline void placeShip(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                             int start_row, int start_col, int size, OrientacaoNavio orientation) {
+    int r, c; // Variáveis para as coordenadas atuais dentro do loop
+    INSTRUMENTAR_INICIO();
+
+    for (int i = 0; i < size; i++) {
+        // Calcula as coordenadas da posição atual do navio com base na orientação
+        switch (orientation) {
+            case HORIZONTAL:          r = start_row;     c = start_col + i; break;
+            case VERTICAL:            r = start_row + i; c = start_col;     break;
+            case DIAGONAL_DOWN_RIGHT: r = start_row + i; c = start_col + i; break;
+            case DIAGONAL_UP_RIGHT:   r = start_row - i; c = start_col + i; break;
+            default:
+                INSTRUMENTAR_FIM(OP_PLACE_SHIP);
+                return; // Orientação inválida: canPlaceShip já a teria recusado
+        }
+        tabuleiro[r][c] = VALOR_NAVIO; // Marca a posição como parte do navio
+    }
+    INSTRUMENTAR_FIM(OP_PLACE_SHIP);
+}
+
+// Versão em bitboard de canPlaceShip: limites e sobreposição em um único AND
+static inline bool canPlaceShipBits(const TabuleiroBits *tabuleiro,
+                                    int start_row, int start_col, int size, OrientacaoNavio orientation) {
+    return (tabuleiro->ocupadas & mascaraNavio(start_row, start_col, size, orientation)) == 0;
+}
+
+// Versão em bitboard de placeShip
+// Assim como placeShip, assume que canPlaceShipBits já confirmou o posicionamento.
+static inline void placeShipBits(TabuleiroBits *tabuleiro,
+                                 int start_row, int start_col, int size, OrientacaoNavio orientation) {
+    Bitboard mascara = mascaraNavio(start_row, start_col, size, orientation) & ~BITBOARD_GUARDA;
+    tabuleiro->navios |= mascara;
+    tabuleiro->habilidades &= ~mascara; // O navio sobrescreve a célula, como em placeShip
+    tabuleiro->ocupadas |= mascara;
+}
+
+// Função para obter uma variante de uma forma registrada (sem nenhum cálculo)
+// O id e a variante devem ser válidos.
+static inline MascaraHabilidade obterHabilidade(const RegistroHabilidades *registro, int id,
+                                                VarianteHabilidade variante) {
+    return registro->variantes[id][variante];
+}
+
+// Função auxiliar para recortar a matriz de habilidade aos limites do tabuleiro
+// Calcula, uma única vez, o intervalo [*inicio, *fim) de índices da habilidade (linhas ou colunas)
+// que caem dentro do tabuleiro quando o centro está na posição 'origem'.
+// Retorna false se nenhuma parte da habilidade cai no tabuleiro.
+static inline bool recortarHabilidade(int origem, int *inicio, int *fim) {
+    if (origem < -HABILIDADE_CENTRO || origem >= TABULEIRO_TAMANHO + HABILIDADE_CENTRO) {
+        return false;
+    }
+    *inicio = origem < HABILIDADE_CENTRO ? HABILIDADE_CENTRO - origem : 0;
+    *fim = origem + HABILIDADE_CENTRO >= TABULEIRO_TAMANHO ? TABULEIRO_TAMANHO + HABILIDADE_CENTRO - origem
+                                                           : HABILIDADE_TAMANHO;
+    return true;
+}
+
+// Função para compactar uma matriz de habilidade 7x7 em uma MascaraHabilidade
+// Apenas células com valor exatamente 1 são consideradas afetadas, como em aplicarHabilidadeAoTabuleiro.
+static inline MascaraHabilidade compactarHabilidade(
+    int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]) {
+    MascaraHabilidade mascara = 0;
+    for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
+        for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
+            mascara |= (MascaraHabilidade)(matriz_habilidade[r][c] == 1) << (r * 8 + c);
+        }
+    }
+    return mascara;
+}
+
+// Função para calcular as células do tabuleiro cobertas por uma habilidade (o "carimbo")
+// As linhas recortadas da máscara são deslocadas para a coluna de destino, limitadas à
+// largura do tabuleiro e encaixadas no bitboard, uma linha por operação.
+static inline Bitboard carimboHabilidade(MascaraHabilidade mascara, int origin_row, int origin_col) {
+    int r_ini, r_fim, c_ini, c_fim;
+    Bitboard carimbo = 0;
+
+    if (!recortarHabilidade(origin_row, &r_ini, &r_fim) || !recortarHabilidade(origin_col, &c_ini, &c_fim)) {
+        return 0;
+    }
+
+    int desloc_col = origin_col - HABILIDADE_CENTRO;
+    uint32_t colunas_validas = ((1u << c_fim) - 1) & ~((1u << c_ini) - 1); // Bits da habilidade no tabuleiro
+    for (int r_hab = r_ini; r_hab < r_fim; r_hab++) {
+        uint32_t linha = HABILIDADE_LINHA(mascara, r_hab) & colunas_validas;
+        linha = desloc_col >= 0 ? linha << desloc_col : linha >> -desloc_col;
+        carimbo |= (Bitboard)linha << ((origin_row + r_hab - HABILIDADE_CENTRO) * TABULEIRO_TAMANHO);
+    }
+    return carimbo;
+}
+
+// Versão em bitboard de aplicarHabilidadeAoTabuleiro
+// Células de água cobertas passam a área de habilidade; células ocupadas não mudam.
+static inline void aplicarHabilidadeBits(TabuleiroBits *tabuleiro, MascaraHabilidade mascara,
+                                         int origin_row, int origin_col) {
+    Bitboard carimbo = carimboHabilidade(mascara, origin_row, origin_col);
+    tabuleiro->habilidades |= carimbo & ~tabuleiro->ocupadas;
+    tabuleiro->ocupadas |= carimbo;
+}
+
+// Bit de cada coluna em uma linha do carimbo (tabela constante em vez de deslocamento
+// variável, para que o laço por coluna possa ser vetorizado sem AVX2)
+static const uint32_t bit_coluna[16] = {
+    1u << 0, 1u << 1, 1u << 2,  1u << 3,  1u << 4,  1u << 5,  1u << 6,  1u << 7,
+    1u << 8, 1u << 9, 1u << 10, 1u << 11, 1u << 12, 1u << 13, 1u << 14, 1u << 15
+};
+
+// Função para aplicar uma máscara compacta de habilidade ao tabuleiro de inteiros
+// O carimbo da habilidade já vem recortado aos limites do tabuleiro; cada linha afetada
+// é então aplicada nas TABULEIRO_TAMANHO células de uma vez, sem desvios, com uma seleção
+// aritmética que o compilador vetoriza (água coberta vira habilidade, o resto é preservado).
+static inline void aplicarMascaraHabilidade(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                                            MascaraHabilidade mascara, int origin_row, int origin_col) {
+    Bitboard carimbo = carimboHabilidade(mascara, origin_row, origin_col);
+    int r_ini, r_fim;
+
+    if (carimbo == 0) {
+        return;
+    }
+    recortarHabilidade(origin_row, &r_ini, &r_fim);
+    for (int r_hab = r_ini; r_hab < r_fim; r_hab++) {
+        int r_tab = origin_row + r_hab - HABILIDADE_CENTRO;
+        uint32_t linha = (uint32_t)(carimbo >> (r_tab * TABULEIRO_TAMANHO)) & ((1u << TABULEIRO_TAMANHO) - 1);
+        int *celulas = tabuleiro[r_tab];
+
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            int afetada = ((linha & bit_coluna[c]) != 0) & (celulas[c] == VALOR_AGUA);
+            celulas[c] = afetada ? VALOR_HABILIDADE : celulas[c];
+        }
+    }
+}
+
+// Função para aplicar a área de efeito de uma habilidade ao tabuleiro principal
+// origin_row, origin_col: centro da habilidade no tabuleiro principal.
+// A matriz é compactada em bits e aplicada linha a linha por aplicarMascaraHabilidade,
+// com o recorte aos limites do tabuleiro feito uma única vez por chamada.
+// Resultado idêntico a aplicarHabilidadeAoTabuleiroReferencia.
+static inline void aplicarHabilidadeAoTabuleiro(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                                                int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO],
+                                                int origin_row, int origin_col) {
+    INSTRUMENTAR_INICIO();
+    aplicarMascaraHabilidade(tabuleiro, compactarHabilidade(matriz_habilidade), origin_row, origin_col);
+    INSTRUMENTAR_FIM(OP_APLICAR_HABILIDADE);
+}
+
+// Função auxiliar para alterar uma célula anotando o valor anterior
+static inline void alterarCelula(TabuleiroDesfazer *tabuleiro, int celula, int valor) {
+    int *destino = &tabuleiro->celulas[0][0] + celula;
+    if (*destino != valor) {
+        AlteracaoCelula *alteracao = &tabuleiro->registro[tabuleiro->quantidade++];
+        alteracao->celula = (uint8_t)celula;
+        alteracao->valor_anterior = *destino;
+        *destino = valor;
+    }
+}
+
+// Função para marcar um instantâneo do tabuleiro
+static inline PontoRestauracao pontoRestauracao(const TabuleiroDesfazer *tabuleiro) {
+    return tabuleiro->quantidade;
+}
+
+// Função auxiliar splitmix64: espalha uma semente de 64 bits para iniciar o gerador
+static inline uint64_t splitmix64(uint64_t *estado) {
+    uint64_t z = (*estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Função auxiliar para rotação de bits à esquerda
+static inline uint64_t rotacionarBits(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Função para sortear o próximo número de 64 bits (xoshiro256**)
+static inline uint64_t proximoAleatorio(GeradorAleatorio *gerador) {
+    uint64_t *s = gerador->s;
+    uint64_t resultado = rotacionarBits(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotacionarBits(s[3], 45);
+    return resultado;
+}
+
+// Função para sortear um inteiro uniforme em [0, limite)
+// Usa a multiplicação de Lemire: sem divisão e sem viés perceptível para limites pequenos.
+static inline uint32_t aleatorioAte(GeradorAleatorio *gerador, uint32_t limite) {
+    return (uint32_t)(((proximoAleatorio(gerador) >> 32) * (uint64_t)limite) >> 32);
+}
+
+// Função para somar 1 ao contador das células de um carimbo (já recortado ao tabuleiro)
+// O vai-um percorre os planos e para assim que se anula (em média, menos de dois planos).
+// Células que passariam do máximo ficam saturadas em INTENSIDADE_MAXIMA.
+static inline void acumularCarimbo(CamadaIntensidade *camada, Bitboard carimbo) {
+    Bitboard vai_um = carimbo;
+    for (int k = 0; k < PLANOS_INTENSIDADE && vai_um; k++) {
+        Bitboard proximo = camada->planos[k] & vai_um;
+        camada->planos[k] ^= vai_um;
+        vai_um = proximo;
+    }
+    if (vai_um) { // Estouro: o contador voltou a zero, então todos os planos são religados
+        for (int k = 0; k < PLANOS_INTENSIDADE; k++) {
+            camada->planos[k] |= vai_um;
+        }
+    }
+    camada->navios_atingidos |= carimbo & camada->navios;
+    camada->habilidades++;
+}
+
+// Função para ler o contador de uma célula
+static inline int intensidadeCelula(const CamadaIntensidade *camada, int celula) {
+    int valor = 0;
+    for (int k = 0; k < PLANOS_INTENSIDADE; k++) {
+        valor |= (int)((camada->planos[k] >> celula) & 1) << k;
+    }
+    return valor;
+}
+
+// Função auxiliar para contar os elementos de um conjunto de posicionamentos
+// Contagem paralela por bits (SWAR), com uma única redução para todas as palavras:
+// sem -mpopcnt, __builtin_popcountll vira uma chamada de biblioteca por palavra.
+static inline int contarPosicionamentos(const ConjuntoPosicionamentos *conjunto) {
+    uint64_t total = 0;
+    for (int w = 0; w < PALAVRAS_POSICIONAMENTOS; w++) {
+        uint64_t x = conjunto->palavras[w];
+        x -= (x >> 1) & 0x5555555555555555ULL;
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        total += (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL; // Cada byte soma até 8 * 7 = 56
+    }
+    total = (total & 0x00FF00FF00FF00FFULL) + ((total >> 8) & 0x00FF00FF00FF00FFULL);
+    return (int)((total * 0x0001000100010001ULL) >> 48);
+}
+
+#endif // BATALHA_NAVAL_H
@@ -0,0 +1,353 @@
+// Benchmarks das primitivas do tabuleiro de Batalha Naval
+// Mede ns/op e ops/s de canPlaceShip, placeShip, aplicarHabilidadeAoTabuleiro, dos
+// construtores criarHabilidade*, do renderizador (sozinho e seguido do fwrite de exibirTabuleiro,
+// com a saída padrão descartada) e do motor de movimento das peças.
+// Cada caso é aquecido, calibrado para durar o tempo pedido e repetido várias vezes;
+// o resultado é a mediana das repetições, com mínimo e máximo.
+//
+// Uso: benchBatalhaNaval [--repeticoes N] [--tempo-ms M] [--filtro TEXTO] [--csv | --json]
+// Compilação: make bench
+
+#define _POSIX_C_SOURCE 200809L // Para clock_gettime, fdopen e dup
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "batalhaNaval.h" // Motor do jogo (biblioteca libbatalhanaval.a)
+
+// --- Tipos dos Casos de Benchmark ---
+#define MAX_REPETICOES 100
+
+// Estado usado pelos casos: tabuleiros e parâmetros fixos de cada um
+typedef struct {
+    int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+    int habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO];
+    int linha, coluna;
+    OrientacaoNavio orientacao;
+    TipoPeca peca;
+    Bitboard bloqueios; // Navios do tabuleiro base, para o motor de movimento
+} ContextoBench;
+
+typedef struct {
+    const char *nome;
+    void (*preparar)(ContextoBench *contexto, int parametro);
+    long long (*executar)(ContextoBench *contexto, long long iteracoes); // Retorna soma de controle
+    int parametro;
+} CasoBench;
+
+typedef enum {
+    SAIDA_TEXTO,
+    SAIDA_CSV,
+    SAIDA_JSON
+} FormatoSaida;
+
+// Resultado agregado, consumido para que o compilador não elimine as chamadas medidas
+static volatile long long sumidouro;
+
+// --- Preparação dos Casos ---
+// Tabuleiro com um navio horizontal em (5,2)-(5,4): alvo dos casos de sobreposição
+
+static void prepararTabuleiroBase(ContextoBench *contexto) {
+    memset(contexto->tabuleiro, 0, sizeof(contexto->tabuleiro));
+    placeShip(contexto->tabuleiro, 5, 2, TAMANHO_NAVIO, HORIZONTAL);
+}
+
+// Posição válida para cada orientação, longe do navio base
+static void prepararAceito(ContextoBench *contexto, int orientacao) {
+    static const int origens[NUM_ORIENTACOES][2] = {{1, 1}, {1, 8}, {3, 6}, {0, 0}};
+    prepararTabuleiroBase(contexto);
+    contexto->orientacao = (OrientacaoNavio)orientacao;
+    contexto->linha = origens[orientacao][0];
+    contexto->coluna = origens[orientacao][1];
+}
+
+// Posição que sai do tabuleiro na última parte do navio
+static void prepararRejeitadoLimites(ContextoBench *contexto, int orientacao) {
+    static const int origens[NUM_ORIENTACOES][2] = {{0, 8}, {8, 0}, {1, 0}, {8, 0}};
+    prepararTabuleiroBase(contexto);
+    contexto->orientacao = (OrientacaoNavio)orientacao;
+    contexto->linha = origens[orientacao][0];
+    contexto->coluna = origens[orientacao][1];
+}
+
+// Posição cuja última parte cai sobre o navio base
+static void prepararRejeitadoSobreposicao(ContextoBench *contexto, int orientacao) {
+    static const int origens[NUM_ORIENTACOES][2] = {{5, 0}, {3, 3}, {7, 2}, {3, 2}};
+    prepararTabuleiroBase(contexto);
+    contexto->orientacao = (OrientacaoNavio)orientacao;
+    contexto->linha = origens[orientacao][0];
+    contexto->coluna = origens[orientacao][1];
+}
+
+// Habilidade 0 cone, 1 cruz, 2 octaedro; origem 0 centro, 1 borda, 2 canto (parametro = forma * 3 + origem)
+static void prepararHabilidade(ContextoBench *contexto, int parametro) {
+    static const int origens[3][2] = {{5, 5}, {0, 5}, {0, 0}};
+    prepararTabuleiroBase(contexto);
+    if (parametro / 3 == 0) {
+        criarHabilidadeCone(contexto->habilidade);
+    } else if (parametro / 3 == 1) {
+        criarHabilidadeCruz(contexto->habilidade);
+    } else {
+        criarHabilidadeOctaedro(contexto->habilidade);
+    }
+    contexto->linha = origens[parametro % 3][0];
+    contexto->coluna = origens[parametro % 3][1];
+}
+
+// Peça do motor de movimento (parametro = TipoPeca), bloqueada pelo navio base
+static void prepararMovimentos(ContextoBench *contexto, int parametro) {
+    TabuleiroBits bits;
+    prepararTabuleiroBase(contexto);
+    matrizParaBitboard(contexto->tabuleiro, &bits);
+    contexto->peca = (TipoPeca)parametro;
+    contexto->bloqueios = bits.navios;
+}
+
+static void prepararNada(ContextoBench *contexto, int parametro) {
+    (void)parametro;
+    prepararTabuleiroBase(contexto);
+}
+
+// --- Execução dos Casos ---
+
+static long long executarCanPlaceShip(ContextoBench *contexto, long long iteracoes) {
+    long long aceitos = 0;
+    for (long long i = 0; i < iteracoes; i++) {
+        aceitos += canPlaceShip(contexto->tabuleiro, contexto->linha, contexto->coluna, TAMANHO_NAVIO,
+                                contexto->orientacao);
+    }
+    return aceitos;
+}
+
+// placeShip sempre na mesma posição: o tabuleiro não muda depois da primeira chamada
+static long long executarPlaceShip(ContextoBench *contexto, long long iteracoes) {
+    for (long long i = 0; i < iteracoes; i++) {
+        placeShip(contexto->tabuleiro, contexto->linha, contexto->coluna, TAMANHO_NAVIO, contexto->orientacao);
+    }
+    return contexto->tabuleiro[contexto->linha][contexto->coluna];
+}
+
+// A habilidade é reaplicada no mesmo tabuleiro: o trabalho por chamada não depende de a
+// água já ter sido marcada, porque todas as células cobertas são verificadas
+static long long executarHabilidade(ContextoBench *contexto, long long iteracoes) {
+    for (long long i = 0; i < iteracoes; i++) {
+        aplicarHabilidadeAoTabuleiro(contexto->tabuleiro, contexto->habilidade, contexto->linha, contexto->coluna);
+    }
+    return contexto->tabuleiro[contexto->linha][contexto->coluna];
+}
+
+static long long executarCriarCone(ContextoBench *contexto, long long iteracoes) {
+    for (long long i = 0; i < iteracoes; i++) {
+        criarHabilidadeCone(contexto->habilidade);
+    }
+    return contexto->habilidade[HABILIDADE_CENTRO][HABILIDADE_CENTRO];
+}
+
+static long long executarCriarCruz(ContextoBench *contexto, long long iteracoes) {
+    for (long long i = 0; i < iteracoes; i++) {
+        criarHabilidadeCruz(contexto->habilidade);
+    }
+    return contexto->habilidade[HABILIDADE_CENTRO][HABILIDADE_CENTRO];
+}
+
+static long long executarCriarOctaedro(ContextoBench *contexto, long long iteracoes) {
+    for (long long i = 0; i < iteracoes; i++) {
+        criarHabilidadeOctaedro(contexto->habilidade);
+    }
+    return contexto->habilidade[HABILIDADE_CENTRO][HABILIDADE_CENTRO];
+}
+
+static long long executarRenderizar(ContextoBench *contexto, long long iteracoes) {
+    char buffer[RENDERIZACAO_MAX_COMPLETO];
+    long long bytes = 0;
+    for (long long i = 0; i < iteracoes; i++) {
+        bytes += (long long)renderizarTabuleiro(contexto->tabuleiro, buffer, FORMATO_COMPLETO);
+    }
+    return bytes + buffer[0];
+}
+
+// O mesmo que exibirTabuleiro do programa: renderiza e escreve na saída padrão, redirecionada
+// para /dev/null pelo main
+static long long executarExibirTabuleiro(ContextoBench *contexto, long long iteracoes) {
+    char buffer[RENDERIZACAO_MAX_COMPLETO];
+    for (long long i = 0; i < iteracoes; i++) {
+        size_t tamanho = renderizarTabuleiro(contexto->tabuleiro, buffer, FORMATO_COMPLETO);
+        fwrite(buffer, 1, tamanho, stdout);
+    }
+    fflush(stdout);
+    return iteracoes;
+}
+
+// Cada iteração gera os lances da peça a partir de uma casa, percorrendo as 100 casas em ciclo
+static long long executarMovimentos(ContextoBench *contexto, long long iteracoes) {
+    long long casas = 0;
+    int celula = 0;
+    for (long long i = 0; i < iteracoes; i++) {
+        casas += contarBits(movimentosPeca(contexto->peca, celula, contexto->bloqueios));
+        celula = celula == TABULEIRO_CELULAS - 1 ? 0 : celula + 1;
+    }
+    return casas;
+}
+
+#define CASOS_ORIENTACAO(preparar, executar, prefixo)                                          \
+    {prefixo "/horizontal", preparar, executar, HORIZONTAL},                                    \
+    {prefixo "/vertical", preparar, executar, VERTICAL},                                        \
+    {prefixo "/diagonal_sobe", preparar, executar, DIAGONAL_UP_RIGHT},                          \
+    {prefixo "/diagonal_desce", preparar, executar, DIAGONAL_DOWN_RIGHT}
+
+#define CASOS_HABILIDADE(forma, indice)                                                         \
+    {"aplicarHabilidadeAoTabuleiro/" forma "/centro", prepararHabilidade, executarHabilidade, indice * 3}, \
+    {"aplicarHabilidadeAoTabuleiro/" forma "/borda", prepararHabilidade, executarHabilidade, indice * 3 + 1}, \
+    {"aplicarHabilidadeAoTabuleiro/" forma "/canto", prepararHabilidade, executarHabilidade, indice * 3 + 2}
+
+static const CasoBench casos[] = {
+    CASOS_ORIENTACAO(prepararAceito, executarCanPlaceShip, "canPlaceShip/aceito"),
+    CASOS_ORIENTACAO(prepararRejeitadoLimites, executarCanPlaceShip, "canPlaceShip/rejeitado_limites"),
+    CASOS_ORIENTACAO(prepararRejeitadoSobreposicao, executarCanPlaceShip, "canPlaceShip/rejeitado_sobreposicao"),
+    CASOS_ORIENTACAO(prepararAceito, executarPlaceShip, "placeShip"),
+    CASOS_HABILIDADE("cone", 0),
+    CASOS_HABILIDADE("cruz", 1),
+    CASOS_HABILIDADE("octaedro", 2),
+    {"criarHabilidadeCone", prepararNada, executarCriarCone, 0},
+    {"criarHabilidadeCruz", prepararNada, executarCriarCruz, 0},
+    {"criarHabilidadeOctaedro", prepararNada, executarCriarOctaedro, 0},
+    {"renderizarTabuleiro", prepararNada, executarRenderizar, 0},
+    {"renderizarTabuleiro/fwrite", prepararNada, executarExibirTabuleiro, 0},
+    {"movimentosPeca/torre", prepararMovimentos, executarMovimentos, PECA_TORRE},
+    {"movimentosPeca/bispo", prepararMovimentos, executarMovimentos, PECA_BISPO},
+    {"movimentosPeca/rainha", prepararMovimentos, executarMovimentos, PECA_RAINHA},
+    {"movimentosPeca/cavalo", prepararMovimentos, executarMovimentos, PECA_CAVALO},
+};
+
+#define NUM_CASOS ((int)(sizeof(casos) / sizeof(casos[0])))
+
+// --- Medição ---
+
+// Função auxiliar para obter o tempo atual em nanossegundos (relógio monotônico)
+static uint64_t tempoNanossegundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Função auxiliar para medir 'iteracoes' execuções de um caso, em nanossegundos
+static uint64_t medirCaso(const CasoBench *caso, ContextoBench *contexto, long long iteracoes) {
+    uint64_t inicio = tempoNanossegundos();
+    sumidouro += caso->executar(contexto, iteracoes);
+    return tempoNanossegundos() - inicio;
+}
+
+// Função para calibrar as iterações de uma repetição (isso também serve de aquecimento):
+// dobra as iterações até uma medição passar de um quarto do tempo pedido e extrapola a
+// partir do menor custo por iteração observado, que não é afetado por interrupções
+static long long calibrarIteracoes(const CasoBench *caso, ContextoBench *contexto, uint64_t tempo_ns) {
+    double melhor = 0.0;
+    uint64_t decorrido = 0;
+
+    for (long long iteracoes = 1; decorrido < tempo_ns / 4 && iteracoes < (1LL << 40); iteracoes *= 2) {
+        decorrido = medirCaso(caso, contexto, iteracoes);
+        double por_iteracao = (double)decorrido / (double)iteracoes;
+        if (decorrido >= 10000 && (melhor == 0.0 || por_iteracao < melhor)) { // Ignora medições < 10 us
+            melhor = por_iteracao;
+        }
+    }
+    long long total = (long long)((double)tempo_ns / (melhor > 0.0 ? melhor : 1.0));
+    return total > 0 ? total : 1;
+}
+
+static int compararDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Função para escrever uma linha de resultado no formato pedido
+static void escreverResultado(FILE *saida, FormatoSaida formato, const char *nome, long long iteracoes,
+                              int repeticoes, const double ns[], bool primeiro) {
+    double mediana = repeticoes % 2 ? ns[repeticoes / 2] : (ns[repeticoes / 2 - 1] + ns[repeticoes / 2]) / 2;
+    double ops = mediana > 0 ? 1e9 / mediana : 0.0;
+
+    if (formato == SAIDA_CSV) {
+        fprintf(saida, "%s,%lld,%d,%.3f,%.3f,%.3f,%.0f\n", nome, iteracoes, repeticoes, mediana, ns[0],
+                ns[repeticoes - 1], ops);
+    } else if (formato == SAIDA_JSON) {
+        fprintf(saida, "%s  {\"caso\": \"%s\", \"iteracoes\": %lld, \"repeticoes\": %d, \"ns_op_mediana\": %.3f, "
+                "\"ns_op_min\": %.3f, \"ns_op_max\": %.3f, \"ops_s\": %.0f}",
+                primeiro ? "" : ",\n", nome, iteracoes, repeticoes, mediana, ns[0], ns[repeticoes - 1], ops);
+    } else {
+        fprintf(saida, "%-52s %10.2f %10.2f %10.2f %14.0f\n", nome, mediana, ns[0], ns[repeticoes - 1], ops);
+    }
+    fflush(saida);
+}
+
+int main(int argc, char *argv[]) {
+    int repeticoes = 5;
+    long long tempo_ms = 100;
+    const char *filtro = NULL;
+    FormatoSaida formato = SAIDA_TEXTO;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--repeticoes") == 0 && i + 1 < argc) {
+            repeticoes = (int)strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--tempo-ms") == 0 && i + 1 < argc) {
+            tempo_ms = strtoll(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--filtro") == 0 && i + 1 < argc) {
+            filtro = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            formato = SAIDA_CSV;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            formato = SAIDA_JSON;
+        } else {
+            fprintf(stderr, "Uso: %s [--repeticoes N] [--tempo-ms M] [--filtro TEXTO] [--csv | --json]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (repeticoes < 1 || repeticoes > MAX_REPETICOES || tempo_ms < 1) {
+        fprintf(stderr, "Erro: repeticoes de 1 a %d e tempo-ms positivo.\n", MAX_REPETICOES);
+        return 1;
+    }
+
+    // Os resultados vão para uma cópia da saída padrão; a saída padrão em si passa a
+    // descartar tudo, para que a escrita do tabuleiro seja medida sem o custo do terminal
+    FILE *saida = fdopen(dup(STDOUT_FILENO), "w");
+    if (saida == NULL || freopen("/dev/null", "w", stdout) == NULL) {
+        fprintf(stderr, "Erro: nao foi possivel redirecionar a saida padrao.\n");
+        return 1;
+    }
+    inicializarBitboards();
+
+    if (formato == SAIDA_CSV) {
+        fprintf(saida, "caso,iteracoes,repeticoes,ns_op_mediana,ns_op_min,ns_op_max,ops_s\n");
+    } else if (formato == SAIDA_JSON) {
+        fprintf(saida, "[\n");
+    } else {
+        fprintf(saida, "%-52s %10s %10s %10s %14s\n", "caso", "ns/op", "min", "max", "ops/s");
+    }
+
+    bool primeiro = true;
+    for (int c = 0; c < NUM_CASOS; c++) {
+        const CasoBench *caso = &casos[c];
+        ContextoBench contexto;
+        double ns[MAX_REPETICOES];
+
+        if (filtro != NULL && strstr(caso->nome, filtro) == NULL) {
+            continue;
+        }
+        caso->preparar(&contexto, caso->parametro);
+        long long iteracoes = calibrarIteracoes(caso, &contexto, (uint64_t)tempo_ms * 1000000ULL);
+        for (int r = 0; r < repeticoes; r++) {
+            ns[r] = (double)medirCaso(caso, &contexto, iteracoes) / (double)iteracoes;
+        }
+        qsort(ns, (size_t)repeticoes, sizeof(double), compararDouble);
+        escreverResultado(saida, formato, caso->nome, iteracoes, repeticoes, ns, primeiro);
+        primeiro = false;
+    }
+
+    if (formato == SAIDA_JSON) {
+        fprintf(saida, "%s]\n", primeiro ? "" : "\n");
+    }
+    fclose(saida);
+    return 0;
+}
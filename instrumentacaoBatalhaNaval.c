@@ -0,0 +1,93 @@
+// Instrumentação opcional das operações principais (parte da biblioteca libbatalhanaval.a)
+// Só tem conteúdo quando compilada com -DINSTRUMENTACAO; os pontos de medição ficam nas
+// funções do motor e em batalhaNaval.h.
+
+#include <stdlib.h>  // Para calloc, getenv e atexit
+#include <pthread.h> // Para a trava da lista de contadores
+
+#include "batalhaNaval.h"
+
+#ifdef INSTRUMENTACAO
+
+_Thread_local ContadoresInstrumentacao *contadores_thread;
+static ContadoresInstrumentacao *lista_contadores;
+static pthread_mutex_t trava_contadores = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t registro_saida = PTHREAD_ONCE_INIT;
+
+// Função para escrever os contadores somados de todas as threads em JSON
+// Executada na saída do programa (atexit), quando as threads de trabalho já terminaram.
+static void despejarInstrumentacao(void) {
+    static const char *operacoes[] = {"canPlaceShip", "placeShip", "aplicarHabilidadeAoTabuleiro",
+                                      "criarHabilidade", "renderizarTabuleiro", "placeShipDesfazer",
+                                      "aplicarHabilidadeAoTabuleiroDesfazer"};
+    static const char *motivos[] = {"orientacao", "limites", "sobreposicao"};
+    ContadoresInstrumentacao total = {0};
+    const char *caminho = getenv("INSTRUMENTACAO_ARQUIVO");
+    FILE *saida = caminho != NULL ? fopen(caminho, "w") : NULL;
+    int threads = 0;
+
+    if (saida == NULL) {
+        saida = stderr;
+    }
+    pthread_mutex_lock(&trava_contadores);
+    for (const ContadoresInstrumentacao *c = lista_contadores; c != NULL; c = c->proximo, threads++) {
+        for (int op = 0; op < NUM_OPERACOES_INSTRUMENTADAS; op++) {
+            total.chamadas[op] += c->chamadas[op];
+            total.ciclos[op] += c->ciclos[op];
+            for (int k = 0; k < FAIXAS_HISTOGRAMA; k++) {
+                total.histograma[op][k] += c->histograma[op][k];
+            }
+        }
+        for (int m = 0; m < NUM_MOTIVOS_REJEICAO; m++) {
+            total.rejeicoes[m] += c->rejeicoes[m];
+        }
+    }
+    pthread_mutex_unlock(&trava_contadores);
+
+    fprintf(saida, "{\n  \"threads\": %d,\n  \"operacoes\": {\n", threads);
+    for (int op = 0; op < NUM_OPERACOES_INSTRUMENTADAS; op++) {
+        int ultima = FAIXAS_HISTOGRAMA - 1;
+        while (ultima > 0 && total.histograma[op][ultima] == 0) {
+            ultima--;
+        }
+        fprintf(saida, "    \"%s\": {\"chamadas\": %llu, \"ciclos\": %llu, \"ciclos_medio\": %.1f, \"histograma_log2\": [",
+                operacoes[op], (unsigned long long)total.chamadas[op], (unsigned long long)total.ciclos[op],
+                total.chamadas[op] > 0 ? (double)total.ciclos[op] / (double)total.chamadas[op] : 0.0);
+        for (int k = 0; k <= ultima; k++) {
+            fprintf(saida, "%s%llu", k > 0 ? ", " : "", (unsigned long long)total.histograma[op][k]);
+        }
+        fprintf(saida, "]}%s\n", op + 1 < NUM_OPERACOES_INSTRUMENTADAS ? "," : "");
+    }
+    fprintf(saida, "  },\n  \"rejeicoes_canPlaceShip\": {");
+    for (int m = 0; m < NUM_MOTIVOS_REJEICAO; m++) {
+        fprintf(saida, "%s\"%s\": %llu", m > 0 ? ", " : "", motivos[m], (unsigned long long)total.rejeicoes[m]);
+    }
+    fprintf(saida, "}\n}\n");
+    if (saida != stderr) {
+        fclose(saida);
+    }
+}
+
+static void registrarSaidaInstrumentacao(void) {
+    atexit(despejarInstrumentacao);
+}
+
+// Função para criar os contadores da thread atual (chamada por contadoresThread na primeira vez)
+// Os contadores nunca são liberados: continuam válidos para o despejo depois que a thread termina.
+ContadoresInstrumentacao *criarContadoresThread(void) {
+    if (contadores_thread == NULL) {
+        ContadoresInstrumentacao *novos = calloc(1, sizeof(ContadoresInstrumentacao));
+        if (novos == NULL) {
+            abort();
+        }
+        pthread_once(&registro_saida, registrarSaidaInstrumentacao);
+        pthread_mutex_lock(&trava_contadores);
+        novos->proximo = lista_contadores;
+        lista_contadores = novos;
+        pthread_mutex_unlock(&trava_contadores);
+        contadores_thread = novos;
+    }
+    return contadores_thread;
+}
+
+#endif // INSTRUMENTACAO
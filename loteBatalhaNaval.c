@@ -0,0 +1,512 @@
+// Processamento de cenários em lote (parte da biblioteca libbatalhanaval.a)
+// Lê cenários de texto (uma frota e uma lista de habilidades por linha, ver batalhaNaval.h),
+// valida os navios com canPlaceShip, aplica as habilidades e escreve uma linha de resultado por
+// cenário, na mesma ordem da entrada.
+//
+// O processamento é um pipeline: a thread que chama processarLote lê blocos de LOTE_CENARIOS
+// linhas para um anel de blocos de tamanho fixo; as threads de trabalho pegam o próximo bloco
+// lido, interpretam e executam seus cenários e formatam a saída no próprio bloco; uma thread
+// escritora grava os blocos em ordem de sequência e devolve cada um ao leitor. O anel limita a
+// memória usada (leitor e trabalhadores esperam quando ele está cheio) e também serve de buffer
+// de reordenação, já que um bloco só é gravado depois de todos os anteriores.
+
+#define _POSIX_C_SOURCE 200809L // Para getline
+
+#include <stdlib.h>  // Para malloc/realloc/free
+#include <string.h>  // Para memcpy e strncmp
+#include <pthread.h> // Para as threads do pipeline
+
+#include "batalhaNaval.h"
+
+// --- Interpretação e Execução de Cenários ---
+
+// Máscara de cada forma padrão, na ordem de IdHabilidade
+static const MascaraHabilidade mascaras_cenario[NUM_HABILIDADES_PADRAO] = {
+    MASCARA_CONE, MASCARA_CRUZ, MASCARA_OCTAEDRO
+};
+
+#define DIGITOS_MAX_CENARIO 6 // Coordenadas de até 6 dígitos (fora do tabuleiro, mas sem estouro)
+
+// Função auxiliar para saber se um caractere separa palavras (ou termina a linha)
+static inline bool separador(char caractere) {
+    return caractere == ' ' || caractere == '\t' || caractere == '\r' || caractere == '\n' || caractere == '\0';
+}
+
+// Função auxiliar para pular espaços
+static inline const char *pularEspacos(const char *p) {
+    while (*p != '\0' && separador(*p)) {
+        p++;
+    }
+    return p;
+}
+
+// Função auxiliar para ler um inteiro com sinal opcional, seguido de separador
+// Retorna false se a palavra não é um número.
+static bool lerNumero(const char **cursor, int *valor) {
+    const char *p = pularEspacos(*cursor);
+    bool negativo = *p == '-';
+    int digitos = 0;
+    int numero = 0;
+
+    if (*p == '-' || *p == '+') {
+        p++;
+    }
+    while (*p >= '0' && *p <= '9' && digitos < DIGITOS_MAX_CENARIO) {
+        numero = numero * 10 + (*p++ - '0');
+        digitos++;
+    }
+    if (digitos == 0 || !separador(*p)) {
+        return false;
+    }
+    *valor = negativo ? -numero : numero;
+    *cursor = p;
+    return true;
+}
+
+// Função auxiliar para ler uma palavra; retorna seu tamanho (0 no fim da linha)
+static size_t lerPalavra(const char **cursor, const char **inicio) {
+    const char *p = pularEspacos(*cursor);
+    *inicio = p;
+    while (!separador(*p)) {
+        p++;
+    }
+    *cursor = p;
+    return (size_t)(p - *inicio);
+}
+
+// Função auxiliar para comparar uma palavra lida com um texto fixo
+static inline bool palavraIgual(const char *palavra, size_t tamanho, const char *texto) {
+    return strlen(texto) == tamanho && strncmp(palavra, texto, tamanho) == 0;
+}
+
+// Função para interpretar uma linha de cenário (terminada em '\0')
+// Retorna false com a mensagem em '*erro' se a linha tem erro de sintaxe ou excede os limites.
+// Uma linha sem diretivas é um cenário vazio; quem lê o arquivo já pula vazias e comentários.
+bool interpretarCenario(const char *texto, Cenario *cenario, const char **erro) {
+    const char *p = texto;
+    const char *palavra;
+    size_t tamanho;
+
+    cenario->quantidade_navios = 0;
+    cenario->quantidade_habilidades = 0;
+    while ((tamanho = lerPalavra(&p, &palavra)) > 0) {
+        if (palavraIgual(palavra, tamanho, "N")) {
+            if (cenario->quantidade_navios >= MAX_NAVIOS_FROTA) {
+                *erro = "navios demais no cenario";
+                return false;
+            }
+            NavioCenario *navio = &cenario->navios[cenario->quantidade_navios++];
+            if (!lerNumero(&p, &navio->linha) || !lerNumero(&p, &navio->coluna)) {
+                *erro = "coordenada de navio invalida";
+                return false;
+            }
+            if (lerPalavra(&p, &palavra) != 1) {
+                *erro = "orientacao invalida (use H, V, S ou D)";
+                return false;
+            }
+            switch (palavra[0]) {
+                case 'H': navio->orientacao = HORIZONTAL; break;
+                case 'V': navio->orientacao = VERTICAL; break;
+                case 'S': navio->orientacao = DIAGONAL_UP_RIGHT; break;
+                case 'D': navio->orientacao = DIAGONAL_DOWN_RIGHT; break;
+                default:
+                    *erro = "orientacao invalida (use H, V, S ou D)";
+                    return false;
+            }
+            // Tamanho opcional: a próxima palavra é um número apenas quando ele foi informado
+            navio->tamanho = TAMANHO_NAVIO;
+            const char *seguinte = pularEspacos(p);
+            if ((*seguinte >= '0' && *seguinte <= '9') &&
+                (!lerNumero(&p, &navio->tamanho) || navio->tamanho < 1 || navio->tamanho > TABULEIRO_TAMANHO)) {
+                *erro = "tamanho de navio invalido";
+                return false;
+            }
+        } else if (palavraIgual(palavra, tamanho, "A")) {
+            if (cenario->quantidade_habilidades >= MAX_HABILIDADES_CENARIO) {
+                *erro = "habilidades demais no cenario";
+                return false;
+            }
+            HabilidadeCenario *habilidade = &cenario->habilidades[cenario->quantidade_habilidades++];
+            tamanho = lerPalavra(&p, &palavra);
+            if (palavraIgual(palavra, tamanho, "cone")) {
+                habilidade->forma = HABILIDADE_CONE;
+            } else if (palavraIgual(palavra, tamanho, "cruz")) {
+                habilidade->forma = HABILIDADE_CRUZ;
+            } else if (palavraIgual(palavra, tamanho, "octaedro")) {
+                habilidade->forma = HABILIDADE_OCTAEDRO;
+            } else {
+                *erro = "forma invalida (use cone, cruz ou octaedro)";
+                return false;
+            }
+            if (!lerNumero(&p, &habilidade->linha) || !lerNumero(&p, &habilidade->coluna)) {
+                *erro = "origem de habilidade invalida";
+                return false;
+            }
+        } else {
+            *erro = "diretiva invalida (use N ou A)";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Função para executar um cenário em um tabuleiro novo
+// Cada navio é validado com canPlaceShip e posicionado com placeShip; os recusados ficam de fora.
+// As habilidades são aplicadas em sequência com aplicarMascaraHabilidade (o núcleo de
+// aplicarHabilidadeAoTabuleiro, com a máscara da forma já compactada).
+void executarCenario(const Cenario *cenario, ResultadoCenario *resultado) {
+    int *celulas = &resultado->tabuleiro[0][0];
+    Bitboard navios = 0;
+
+    for (int i = 0; i < TABULEIRO_CELULAS; i++) {
+        celulas[i] = VALOR_AGUA;
+    }
+    resultado->navios_posicionados = 0;
+    for (int i = 0; i < cenario->quantidade_navios; i++) {
+        const NavioCenario *navio = &cenario->navios[i];
+        if (canPlaceShip(resultado->tabuleiro, navio->linha, navio->coluna, navio->tamanho, navio->orientacao)) {
+            placeShip(resultado->tabuleiro, navio->linha, navio->coluna, navio->tamanho, navio->orientacao);
+            navios |= mascaraNavio(navio->linha, navio->coluna, navio->tamanho, navio->orientacao);
+            resultado->navios_posicionados++;
+        }
+    }
+    for (int i = 0; i < cenario->quantidade_habilidades; i++) {
+        const HabilidadeCenario *habilidade = &cenario->habilidades[i];
+        MascaraHabilidade mascara = mascaras_cenario[habilidade->forma];
+        Bitboard carimbo = carimboHabilidade(mascara, habilidade->linha, habilidade->coluna);
+        resultado->atingidos[i] = contarBits(carimbo & navios);
+        aplicarMascaraHabilidade(resultado->tabuleiro, mascara, habilidade->linha, habilidade->coluna);
+    }
+
+    int marcadas = 0;
+    for (int i = 0; i < TABULEIRO_CELULAS; i++) {
+        marcadas += celulas[i] == VALOR_HABILIDADE;
+    }
+    resultado->celulas_habilidade = marcadas;
+}
+
+// Função auxiliar para escrever um inteiro sem sinal em decimal
+static char *escreverNumero(char *destino, uint64_t valor) {
+    char digitos[20];
+    int n = 0;
+    do {
+        digitos[n++] = (char)('0' + valor % 10);
+        valor /= 10;
+    } while (valor > 0);
+    while (n > 0) {
+        *destino++ = digitos[--n];
+    }
+    return destino;
+}
+
+// Função auxiliar para escrever um texto fixo
+static char *escreverTexto(char *destino, const char *texto) {
+    size_t tamanho = strlen(texto);
+    memcpy(destino, texto, tamanho);
+    return destino + tamanho;
+}
+
+// Função para formatar o resultado de um cenário em uma linha terminada em '\n'
+//   <linha> ok navios=<posicionados>/<total> atingidos=<a1>,<a2>,... habilidade=<células> tabuleiro=<10 linhas>
+// O tabuleiro usa os caracteres do formato compacto, com as linhas separadas por '/'.
+// 'destino' deve ter SAIDA_MAX_CENARIO bytes. Retorna a quantidade de bytes escritos.
+size_t formatarResultadoCenario(uint64_t numero_linha, const Cenario *cenario, const ResultadoCenario *resultado,
+                                char *destino) {
+    char *p = escreverNumero(destino, numero_linha);
+
+    p = escreverTexto(p, " ok navios=");
+    p = escreverNumero(p, (uint64_t)resultado->navios_posicionados);
+    *p++ = '/';
+    p = escreverNumero(p, (uint64_t)cenario->quantidade_navios);
+    p = escreverTexto(p, " atingidos=");
+    if (cenario->quantidade_habilidades == 0) {
+        *p++ = '-';
+    }
+    for (int i = 0; i < cenario->quantidade_habilidades; i++) {
+        if (i > 0) {
+            *p++ = ',';
+        }
+        p = escreverNumero(p, (uint64_t)resultado->atingidos[i]);
+    }
+    p = escreverTexto(p, " habilidade=");
+    p = escreverNumero(p, (uint64_t)resultado->celulas_habilidade);
+    p = escreverTexto(p, " tabuleiro=");
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        if (r > 0) {
+            *p++ = '/';
+        }
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            int valor = resultado->tabuleiro[r][c];
+            *p++ = valor == VALOR_AGUA ? '~' : valor == VALOR_NAVIO ? 'N' : valor == VALOR_HABILIDADE ? 'A' : '?';
+        }
+    }
+    *p++ = '\n';
+    return (size_t)(p - destino);
+}
+
+// Função auxiliar para formatar a linha de erro de um cenário
+static size_t formatarErroCenario(uint64_t numero_linha, const char *erro, char *destino) {
+    char *p = escreverNumero(destino, numero_linha);
+    p = escreverTexto(p, " erro ");
+    p = escreverTexto(p, erro);
+    *p++ = '\n';
+    return (size_t)(p - destino);
+}
+
+// --- Pipeline de Processamento em Lote ---
+#define LOTE_CENARIOS 256        // Linhas de cenário por bloco
+#define TEXTO_INICIAL_BLOCO 16384 // Capacidade inicial do texto de um bloco (cresce se preciso)
+
+typedef enum {
+    BLOCO_LIVRE,      // Disponível para o leitor
+    BLOCO_LIDO,       // Com linhas, esperando (ou em) processamento
+    BLOCO_PROCESSADO  // Com a saída pronta, esperando a vez de ser gravado
+} EstadoBloco;
+
+// Bloco de linhas em trânsito no pipeline (texto das linhas e saída formatada)
+typedef struct {
+    EstadoBloco estado;
+    int quantidade;
+    char *texto; // Linhas terminadas em '\0', uma após a outra
+    size_t tamanho_texto;
+    size_t capacidade_texto;
+    uint32_t inicio[LOTE_CENARIOS];        // Posição de cada linha em 'texto'
+    uint64_t numero_linha[LOTE_CENARIOS];  // Linha de origem (1 = primeira linha da entrada)
+    char *saida; // LOTE_CENARIOS * SAIDA_MAX_CENARIO bytes
+    size_t tamanho_saida;
+    EstatisticasLote estatisticas;
+} BlocoLote;
+
+// Estado compartilhado do pipeline; a trava protege os estados dos blocos e os contadores
+typedef struct {
+    pthread_mutex_t trava;
+    pthread_cond_t bloco_lido;
+    pthread_cond_t bloco_processado;
+    pthread_cond_t bloco_livre;
+    BlocoLote *blocos;
+    int capacidade;
+    uint64_t lidos;             // Blocos entregues pelo leitor
+    uint64_t proximo_trabalho;  // Próximo bloco a ser pego por um trabalhador
+    uint64_t gravados;          // Blocos já gravados pelo escritor
+    bool fim_entrada;
+    bool erro_escrita;
+    FILE *saida;
+    EstatisticasLote estatisticas;
+} EstadoLote;
+
+// Função auxiliar para processar todas as linhas de um bloco
+static void processarBloco(BlocoLote *bloco) {
+    Cenario cenario;
+    ResultadoCenario resultado;
+    const char *erro;
+    char *saida = bloco->saida;
+
+    bloco->estatisticas = (EstatisticasLote){0};
+    for (int i = 0; i < bloco->quantidade; i++) {
+        uint64_t numero_linha = bloco->numero_linha[i];
+        bloco->estatisticas.cenarios++;
+        if (interpretarCenario(bloco->texto + bloco->inicio[i], &cenario, &erro)) {
+            executarCenario(&cenario, &resultado);
+            bloco->estatisticas.navios_rejeitados +=
+                (uint64_t)(cenario.quantidade_navios - resultado.navios_posicionados);
+            saida += formatarResultadoCenario(numero_linha, &cenario, &resultado, saida);
+        } else {
+            bloco->estatisticas.erros++;
+            saida += formatarErroCenario(numero_linha, erro, saida);
+        }
+    }
+    bloco->tamanho_saida = (size_t)(saida - bloco->saida);
+}
+
+// Função executada por cada thread de trabalho: pega blocos lidos na ordem em que chegaram
+static void *trabalhadorLote(void *argumento) {
+    EstadoLote *estado = argumento;
+
+    for (;;) {
+        pthread_mutex_lock(&estado->trava);
+        while (estado->proximo_trabalho >= estado->lidos && !estado->fim_entrada) {
+            pthread_cond_wait(&estado->bloco_lido, &estado->trava);
+        }
+        if (estado->proximo_trabalho >= estado->lidos) {
+            pthread_mutex_unlock(&estado->trava); // Entrada terminou e não há mais blocos
+            return NULL;
+        }
+        BlocoLote *bloco = &estado->blocos[estado->proximo_trabalho++ % (uint64_t)estado->capacidade];
+        pthread_mutex_unlock(&estado->trava);
+
+        processarBloco(bloco);
+
+        pthread_mutex_lock(&estado->trava);
+        bloco->estado = BLOCO_PROCESSADO;
+        pthread_cond_broadcast(&estado->bloco_processado);
+        pthread_mutex_unlock(&estado->trava);
+    }
+}
+
+// Função executada pela thread escritora: grava os blocos em ordem e os devolve ao leitor
+static void *escritorLote(void *argumento) {
+    EstadoLote *estado = argumento;
+
+    for (;;) {
+        pthread_mutex_lock(&estado->trava);
+        BlocoLote *bloco = &estado->blocos[estado->gravados % (uint64_t)estado->capacidade];
+        while (!(estado->gravados < estado->lidos && bloco->estado == BLOCO_PROCESSADO) &&
+               !(estado->fim_entrada && estado->gravados == estado->lidos)) {
+            pthread_cond_wait(&estado->bloco_processado, &estado->trava);
+        }
+        if (estado->gravados == estado->lidos) {
+            pthread_mutex_unlock(&estado->trava); // Tudo gravado
+            return NULL;
+        }
+        pthread_mutex_unlock(&estado->trava);
+
+        bool gravou = fwrite(bloco->saida, 1, bloco->tamanho_saida, estado->saida) == bloco->tamanho_saida;
+
+        pthread_mutex_lock(&estado->trava);
+        estado->erro_escrita |= !gravou;
+        estado->estatisticas.cenarios += bloco->estatisticas.cenarios;
+        estado->estatisticas.erros += bloco->estatisticas.erros;
+        estado->estatisticas.navios_rejeitados += bloco->estatisticas.navios_rejeitados;
+        bloco->estado = BLOCO_LIVRE;
+        estado->gravados++;
+        pthread_cond_signal(&estado->bloco_livre);
+        pthread_mutex_unlock(&estado->trava);
+    }
+}
+
+// Função auxiliar para acrescentar uma linha ao texto do bloco
+// Retorna false se não houver memória.
+static bool acrescentarLinha(BlocoLote *bloco, const char *linha, size_t tamanho, uint64_t numero_linha) {
+    if (bloco->tamanho_texto + tamanho + 1 > bloco->capacidade_texto) {
+        size_t capacidade = bloco->capacidade_texto * 2;
+        while (capacidade < bloco->tamanho_texto + tamanho + 1) {
+            capacidade *= 2;
+        }
+        char *texto = realloc(bloco->texto, capacidade);
+        if (texto == NULL) {
+            return false;
+        }
+        bloco->texto = texto;
+        bloco->capacidade_texto = capacidade;
+    }
+    memcpy(bloco->texto + bloco->tamanho_texto, linha, tamanho);
+    bloco->texto[bloco->tamanho_texto + tamanho] = '\0';
+    bloco->inicio[bloco->quantidade] = (uint32_t)bloco->tamanho_texto;
+    bloco->numero_linha[bloco->quantidade] = numero_linha;
+    bloco->quantidade++;
+    bloco->tamanho_texto += tamanho + 1;
+    return true;
+}
+
+// Função auxiliar para obter o próximo bloco livre do anel (espera o escritor liberá-lo)
+static BlocoLote *proximoBlocoLivre(EstadoLote *estado) {
+    pthread_mutex_lock(&estado->trava);
+    BlocoLote *bloco = &estado->blocos[estado->lidos % (uint64_t)estado->capacidade];
+    while (bloco->estado != BLOCO_LIVRE) {
+        pthread_cond_wait(&estado->bloco_livre, &estado->trava);
+    }
+    pthread_mutex_unlock(&estado->trava);
+    bloco->quantidade = 0;
+    bloco->tamanho_texto = 0;
+    return bloco;
+}
+
+// Função auxiliar para entregar um bloco preenchido aos trabalhadores
+static void entregarBloco(EstadoLote *estado, BlocoLote *bloco) {
+    pthread_mutex_lock(&estado->trava);
+    bloco->estado = BLOCO_LIDO;
+    estado->lidos++;
+    pthread_cond_signal(&estado->bloco_lido);
+    pthread_mutex_unlock(&estado->trava);
+}
+
+// Função para processar todos os cenários de 'entrada' e escrever os resultados em 'saida'
+// 'threads' trabalhadores processam os blocos em paralelo (mínimo 1); a saída segue a ordem
+// da entrada, com uma linha por cenário (resultado ou erro de sintaxe). As estatísticas podem
+// ser NULL. Retorna false em erro de leitura, de escrita ou de memória.
+bool processarLote(FILE *entrada, FILE *saida, int threads, EstatisticasLote *estatisticas) {
+    EstadoLote estado = {
+        .trava = PTHREAD_MUTEX_INITIALIZER,
+        .bloco_lido = PTHREAD_COND_INITIALIZER,
+        .bloco_processado = PTHREAD_COND_INITIALIZER,
+        .bloco_livre = PTHREAD_COND_INITIALIZER,
+        .saida = saida,
+    };
+    bool sucesso = true;
+
+    threads = threads < 1 ? 1 : threads;
+    estado.capacidade = 2 * threads + 2; // Blocos em leitura, em processamento e na fila de gravação
+    estado.blocos = calloc((size_t)estado.capacidade, sizeof(BlocoLote));
+    pthread_t *ids = malloc((size_t)(threads + 1) * sizeof(pthread_t));
+    if (estado.blocos == NULL || ids == NULL) {
+        free(estado.blocos);
+        free(ids);
+        return false;
+    }
+    for (int i = 0; i < estado.capacidade; i++) {
+        estado.blocos[i].texto = malloc(TEXTO_INICIAL_BLOCO);
+        estado.blocos[i].capacidade_texto = TEXTO_INICIAL_BLOCO;
+        estado.blocos[i].saida = malloc((size_t)LOTE_CENARIOS * SAIDA_MAX_CENARIO);
+        sucesso &= estado.blocos[i].texto != NULL && estado.blocos[i].saida != NULL;
+    }
+
+    int criadas = 0;
+    if (sucesso && pthread_create(&ids[0], NULL, escritorLote, &estado) == 0) {
+        for (criadas = 1; criadas <= threads; criadas++) {
+            if (pthread_create(&ids[criadas], NULL, trabalhadorLote, &estado) != 0) {
+                break;
+            }
+        }
+    }
+
+    // Leitura na thread que chamou: linhas vazias e comentários contam na numeração, mas não geram saída
+    if (criadas > 1) {
+        char *linha = NULL;
+        size_t capacidade = 0;
+        ssize_t tamanho;
+        uint64_t numero_linha = 0;
+        BlocoLote *bloco = proximoBlocoLivre(&estado);
+
+        while ((tamanho = getline(&linha, &capacidade, entrada)) >= 0) {
+            const char *conteudo = pularEspacos(linha);
+            numero_linha++;
+            if (*conteudo == '\0' || *conteudo == '#') {
+                continue;
+            }
+            if (!acrescentarLinha(bloco, linha, (size_t)tamanho, numero_linha)) {
+                sucesso = false;
+                break;
+            }
+            if (bloco->quantidade == LOTE_CENARIOS) {
+                entregarBloco(&estado, bloco);
+                bloco = proximoBlocoLivre(&estado);
+            }
+        }
+        if (bloco->quantidade > 0) {
+            entregarBloco(&estado, bloco);
+        }
+        sucesso &= !ferror(entrada);
+        free(linha);
+    }
+
+    pthread_mutex_lock(&estado.trava);
+    estado.fim_entrada = true;
+    pthread_cond_broadcast(&estado.bloco_lido);
+    pthread_cond_broadcast(&estado.bloco_processado);
+    pthread_mutex_unlock(&estado.trava);
+    for (int i = 0; i < criadas; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    sucesso &= criadas > 1 && !estado.erro_escrita;
+
+    for (int i = 0; i < estado.capacidade; i++) {
+        free(estado.blocos[i].texto);
+        free(estado.blocos[i].saida);
+    }
+    free(estado.blocos);
+    free(ids);
+    if (estatisticas != NULL) {
+        *estatisticas = estado.estatisticas;
+    }
+    return sucesso;
+}
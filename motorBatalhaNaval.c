@@ -0,0 +1,1693 @@
+// Motor de Batalha Naval (biblioteca libbatalhanaval.a)
+// Tabuleiros, posicionamentos, habilidades, gerador de frotas, simulação, solver e enumeração.
+// A interface pública e as funções 'static inline' do caminho quente estão em batalhaNaval.h.
+
+#include <stdlib.h>    // Para malloc/free
+#include <string.h>    // Para memcpy e memset
+#include <pthread.h>   // Para as threads da simulação e da enumeração
+#include <stdatomic.h> // Para contadores compartilhados sem trava
+
+#include "batalhaNaval.h"
+
+// --- Renderizador de Tabuleiros em Buffer ---
+// Em vez de uma chamada de printf por célula, o tabuleiro inteiro é montado em um buffer
+// fornecido pelo chamador, que o escreve com uma única chamada de fwrite.
+
+// Função auxiliar para escrever um inteiro em decimal no buffer
+// Retorna o ponteiro para a posição logo após o último dígito.
+static char *escreverInteiro(char *destino, int valor) {
+    char digitos[12];
+    int n = 0;
+    unsigned int absoluto = valor < 0 ? 0u - (unsigned int)valor : (unsigned int)valor;
+
+    do {
+        digitos[n++] = (char)('0' + absoluto % 10);
+        absoluto /= 10;
+    } while (absoluto > 0);
+    if (valor < 0) {
+        *destino++ = '-';
+    }
+    while (n > 0) {
+        *destino++ = digitos[--n];
+    }
+    return destino;
+}
+
+// Função auxiliar para escrever a linha separadora do formato completo
+static char *escreverSeparador(char *destino) {
+    static const char separador[] = "  --------------------------------\n";
+    memcpy(destino, separador, sizeof(separador) - 1);
+    return destino + sizeof(separador) - 1;
+}
+
+// Função auxiliar para escrever o cabeçalho de colunas e o separador do formato completo
+static char *escreverCabecalho(char *destino) {
+    *destino++ = ' ';
+    *destino++ = ' ';
+    *destino++ = ' ';
+    for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+        destino = escreverInteiro(destino, c);
+        *destino++ = ' ';
+    }
+    *destino++ = '\n';
+    return escreverSeparador(destino);
+}
+
+// Função para renderizar o tabuleiro no buffer 'destino'
+// 'destino' deve ter RENDERIZACAO_MAX_COMPLETO ou RENDERIZACAO_MAX_COMPACTO bytes, conforme o formato.
+// Retorna a quantidade de bytes escritos (sem terminador nulo).
+size_t renderizarTabuleiro(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO], char *destino,
+                           FormatoRenderizacao formato) {
+    char *p = destino;
+    INSTRUMENTAR_INICIO();
+
+    if (formato == FORMATO_COMPACTO) {
+        for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+            for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+                int valor = tabuleiro[r][c];
+                *p++ = valor == VALOR_AGUA ? '~' : valor == VALOR_NAVIO ? 'N'
+                     : valor == VALOR_HABILIDADE ? 'A' : (valor >= 0 && valor <= 9) ? (char)('0' + valor) : '?';
+            }
+            *p++ = '\n';
+        }
+        INSTRUMENTAR_FIM(OP_RENDERIZAR);
+        return (size_t)(p - destino);
+    }
+
+    p = escreverCabecalho(p);
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        p = escreverInteiro(p, r);
+        *p++ = ' ';
+        *p++ = '|';
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            int valor = tabuleiro[r][c];
+            if (valor == VALOR_AGUA) {
+                *p++ = '~';
+            } else if (valor == VALOR_NAVIO) {
+                *p++ = 'N';
+            } else if (valor == VALOR_HABILIDADE) {
+                *p++ = 'A';
+            } else {
+                p = escreverInteiro(p, valor); // Qualquer outro valor inesperado
+            }
+            *p++ = ' ';
+        }
+        *p++ = '|';
+        *p++ = '\n';
+    }
+    p = escreverSeparador(p);
+    *p++ = '\n';
+    INSTRUMENTAR_FIM(OP_RENDERIZAR);
+    return (size_t)(p - destino);
+}
+
+// Função para renderizar vários tabuleiros em sequência no mesmo buffer
+// 'destino' deve ter quantidade * RENDERIZACAO_MAX_* bytes. Retorna o total de bytes escritos.
+size_t renderizarTabuleiros(int tabuleiros[][TABULEIRO_TAMANHO][TABULEIRO_TAMANHO], int quantidade,
+                            char *destino, FormatoRenderizacao formato) {
+    size_t total = 0;
+    for (int i = 0; i < quantidade; i++) {
+        total += renderizarTabuleiro(tabuleiros[i], destino + total, formato);
+    }
+    return total;
+}
+
+// Função para renderizar uma matriz de habilidade no buffer 'destino' (valores separados por
+// espaço e uma linha em branco no final). 'destino' deve ter RENDERIZACAO_MAX_HABILIDADE bytes.
+// Retorna a quantidade de bytes escritos (sem terminador nulo).
+size_t renderizarHabilidade(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO], char *destino) {
+    char *p = destino;
+
+    for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
+        for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
+            p = escreverInteiro(p, matriz_habilidade[r][c]);
+            *p++ = ' ';
+        }
+        *p++ = '\n';
+    }
+    *p++ = '\n';
+    return (size_t)(p - destino);
+}
+
+// --- Representação do Tabuleiro em Bitboard ---
+// Cada célula do tabuleiro 10x10 corresponde a um bit de um inteiro de 128 bits
+// (bit = linha * TABULEIRO_TAMANHO + coluna). Os bits 100 a 127 não pertencem ao
+// tabuleiro e ficam sempre ligados na máscara de ocupação: são os "bits de guarda".
+// Um posicionamento fora dos limites é representado por uma máscara que contém
+// um bit de guarda, de modo que limites e sobreposição são testados com um único AND.
+
+// Função para obter o deslocamento (linha, coluna) de cada passo de uma orientação
+// Retorna false para uma orientação inválida.
+bool deslocamentoOrientacao(OrientacaoNavio orientation, int *delta_row, int *delta_col) {
+    switch (orientation) {
+        case HORIZONTAL:          *delta_row = 0;  *delta_col = 1; return true;
+        case VERTICAL:            *delta_row = 1;  *delta_col = 0; return true;
+        case DIAGONAL_UP_RIGHT:   *delta_row = -1; *delta_col = 1; return true;
+        case DIAGONAL_DOWN_RIGHT: *delta_row = 1;  *delta_col = 1; return true;
+    }
+    return false;
+}
+
+// Tabela de máscaras de todos os posicionamentos (tamanho, orientação, linha, coluna)
+// Preenchida uma única vez por inicializarBitboards(); declarada em batalhaNaval.h para mascaraNavio.
+Bitboard mascaras_navio[TABULEIRO_TAMANHO][NUM_ORIENTACOES][TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+
+// Tabela com apenas os posicionamentos legais, agrupados por tamanho do navio.
+// Os posicionamentos de tamanho 's' ocupam os índices [inicio_posicionamentos[s], inicio_posicionamentos[s + 1]).
+static PosicionamentoNavio posicionamentos[MAX_POSICIONAMENTOS];
+static int inicio_posicionamentos[TABULEIRO_TAMANHO + 2];
+
+// Conjuntos de posicionamentos (um bit por posicionamento do mesmo tamanho) que cobrem cada célula.
+// cobertura_posicionamentos[s - 1][celula] marca os posicionamentos de tamanho 's' que usam a célula;
+// remover esses bits de um conjunto de candidatos equivale a testar sobreposição com ela.
+static uint64_t cobertura_posicionamentos[TABULEIRO_TAMANHO][TABULEIRO_CELULAS][PALAVRAS_POSICIONAMENTOS];
+
+static void inicializarMovimentos(void);
+
+// Função para preencher as tabelas de máscaras do bitboard
+// Deve ser chamada uma vez no início do programa, antes de qualquer função *Bits
+// e do motor de movimento.
+void inicializarBitboards(void) {
+    int total = 0; // Posicionamentos legais gerados até agora
+
+    inicio_posicionamentos[0] = 0;
+    for (int size = 1; size <= TABULEIRO_TAMANHO; size++) {
+        inicio_posicionamentos[size] = total;
+        for (int o = 0; o < NUM_ORIENTACOES; o++) {
+            int dr, dc;
+            deslocamentoOrientacao((OrientacaoNavio)o, &dr, &dc);
+            for (int row = 0; row < TABULEIRO_TAMANHO; row++) {
+                for (int col = 0; col < TABULEIRO_TAMANHO; col++) {
+                    // Posições da última parte do navio definem se ele cabe no tabuleiro
+                    int r_fim = row + dr * (size - 1);
+                    int c_fim = col + dc * (size - 1);
+                    Bitboard mascara = 0;
+
+                    if (r_fim < 0 || r_fim >= TABULEIRO_TAMANHO || c_fim >= TABULEIRO_TAMANHO) {
+                        mascara = BITBOARD_FORA; // Fora dos limites: sempre colide com a guarda
+                    } else {
+                        for (int i = 0; i < size; i++) {
+                            mascara |= BITBOARD_CELULA(row + dr * i, col + dc * i);
+                        }
+                        // Apenas posicionamentos dentro dos limites entram na tabela de legais
+                        posicionamentos[total].mascara = mascara;
+                        posicionamentos[total].linha = (uint8_t)row;
+                        posicionamentos[total].coluna = (uint8_t)col;
+                        posicionamentos[total].tamanho = (uint8_t)size;
+                        posicionamentos[total].orientacao = (uint8_t)o;
+                        posicionamentos[total].celula = (uint8_t)(row * TABULEIRO_TAMANHO + col);
+                        posicionamentos[total].passo = (int8_t)(dr * TABULEIRO_TAMANHO + dc);
+                        total++;
+                    }
+                    mascaras_navio[size - 1][o][row][col] = mascara;
+                }
+            }
+        }
+    }
+    inicio_posicionamentos[TABULEIRO_TAMANHO + 1] = total;
+
+    // Conjuntos de cobertura por célula, usados pelo gerador de frotas
+    for (int size = 1; size <= TABULEIRO_TAMANHO; size++) {
+        for (int i = inicio_posicionamentos[size]; i < inicio_posicionamentos[size + 1]; i++) {
+            int relativo = i - inicio_posicionamentos[size];
+            for (int celula = 0; celula < TABULEIRO_CELULAS; celula++) {
+                if (posicionamentos[i].mascara & ((Bitboard)1 << celula)) {
+                    cobertura_posicionamentos[size - 1][celula][relativo / 64] |= 1ULL << (relativo % 64);
+                }
+            }
+        }
+    }
+
+    inicializarMovimentos();
+}
+
+// Função para obter os posicionamentos legais (dentro dos limites) de um tamanho de navio
+// Retorna um ponteiro para o primeiro posicionamento e grava a quantidade em '*quantidade'.
+// Os índices usados por listarPosicionamentosLegais são relativos a esse ponteiro.
+const PosicionamentoNavio *posicionamentosDoTamanho(int size, int *quantidade) {
+    if (size < 1 || size > TABULEIRO_TAMANHO) {
+        *quantidade = 0;
+        return posicionamentos;
+    }
+    *quantidade = inicio_posicionamentos[size + 1] - inicio_posicionamentos[size];
+    return &posicionamentos[inicio_posicionamentos[size]];
+}
+
+// Função para limpar o tabuleiro em bitboard (todas as células com água)
+void limparTabuleiroBits(TabuleiroBits *tabuleiro) {
+    tabuleiro->ocupadas = BITBOARD_GUARDA;
+    tabuleiro->navios = 0;
+    tabuleiro->habilidades = 0;
+}
+
+// Função para listar todos os posicionamentos legais de um navio no tabuleiro atual
+// Percorre a tabela pré-calculada do tamanho pedido e mantém os que não colidem com
+// nenhuma célula ocupada. Grava os índices (relativos a posicionamentosDoTamanho)
+// em 'indices', que deve ter espaço para todos os posicionamentos do tamanho, e
+// retorna quantos foram encontrados.
+int listarPosicionamentosLegais(const TabuleiroBits *tabuleiro, int size, uint16_t indices[]) {
+    int quantidade;
+    const PosicionamentoNavio *tabela = posicionamentosDoTamanho(size, &quantidade);
+    Bitboard ocupadas = tabuleiro->ocupadas;
+    int encontrados = 0;
+
+    for (int i = 0; i < quantidade; i++) {
+        // Escrita incondicional: o contador só avança quando o posicionamento é livre
+        indices[encontrados] = (uint16_t)i;
+        encontrados += (tabela[i].mascara & ocupadas) == 0;
+    }
+    return encontrados;
+}
+
+// Função para converter a matriz de inteiros em bitboard
+// Valores diferentes de água, navio e habilidade contam apenas como células ocupadas.
+void matrizParaBitboard(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO], TabuleiroBits *bits) {
+    limparTabuleiroBits(bits);
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            Bitboard celula = BITBOARD_CELULA(r, c);
+            if (tabuleiro[r][c] == VALOR_NAVIO) {
+                bits->navios |= celula;
+            } else if (tabuleiro[r][c] == VALOR_HABILIDADE) {
+                bits->habilidades |= celula;
+            }
+            if (tabuleiro[r][c] != VALOR_AGUA) {
+                bits->ocupadas |= celula;
+            }
+        }
+    }
+}
+
+// Função para converter o bitboard de volta para a matriz de inteiros
+// Células ocupadas que não são navio nem habilidade não têm valor conhecido e voltam como água.
+void bitboardParaMatriz(const TabuleiroBits *bits, int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]) {
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            Bitboard celula = BITBOARD_CELULA(r, c);
+            if (bits->navios & celula) {
+                tabuleiro[r][c] = VALOR_NAVIO;
+            } else if (bits->habilidades & celula) {
+                tabuleiro[r][c] = VALOR_HABILIDADE;
+            } else {
+                tabuleiro[r][c] = VALOR_AGUA;
+            }
+        }
+    }
+}
+
+// Função para expandir uma máscara compacta na matriz de habilidade 7x7 (0 ou 1 por célula)
+void expandirHabilidade(MascaraHabilidade mascara, int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]) {
+    for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
+        for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
+            matriz_habilidade[r][c] = (int)((mascara >> (r * 8 + c)) & 1);
+        }
+    }
+}
+
+// Função para criar a matriz de habilidade em forma de CONE (apontando para baixo)
+// A forma vem da constante MASCARA_CONE, calculada em tempo de compilação.
+void criarHabilidadeCone(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]) {
+    INSTRUMENTAR_INICIO();
+    expandirHabilidade(MASCARA_CONE, matriz_habilidade);
+    INSTRUMENTAR_FIM(OP_CRIAR_HABILIDADE);
+}
+
+// Função para criar a matriz de habilidade em forma de CRUZ
+void criarHabilidadeCruz(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]) {
+    INSTRUMENTAR_INICIO();
+    expandirHabilidade(MASCARA_CRUZ, matriz_habilidade);
+    INSTRUMENTAR_FIM(OP_CRIAR_HABILIDADE);
+}
+
+// Função para criar a matriz de habilidade em forma de OCTAEDRO (losango)
+void criarHabilidadeOctaedro(int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO]) {
+    INSTRUMENTAR_INICIO();
+    expandirHabilidade(MASCARA_OCTAEDRO, matriz_habilidade);
+    INSTRUMENTAR_FIM(OP_CRIAR_HABILIDADE);
+}
+
+// Função para girar uma máscara de habilidade 90 graus no sentido horário
+// A célula [r][c] da forma girada vem da célula [TAMANHO-1-c][r] da original.
+MascaraHabilidade rotacionarHabilidade(MascaraHabilidade mascara) {
+    MascaraHabilidade girada = 0;
+    for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
+        for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
+            if (mascara & HABILIDADE_BIT(HABILIDADE_TAMANHO - 1 - c, r)) {
+                girada |= HABILIDADE_BIT(r, c);
+            }
+        }
+    }
+    return girada;
+}
+
+// Função para espelhar uma máscara de habilidade (esquerda <-> direita)
+MascaraHabilidade espelharHabilidade(MascaraHabilidade mascara) {
+    MascaraHabilidade espelhada = 0;
+    for (int r = 0; r < HABILIDADE_TAMANHO; r++) {
+        for (int c = 0; c < HABILIDADE_TAMANHO; c++) {
+            if (mascara & HABILIDADE_BIT(r, HABILIDADE_TAMANHO - 1 - c)) {
+                espelhada |= HABILIDADE_BIT(r, c);
+            }
+        }
+    }
+    return espelhada;
+}
+
+// Função para registrar uma forma de habilidade e pré-calcular suas 8 variantes
+// Retorna o id da forma, ou -1 se o registro estiver cheio.
+int registrarHabilidade(RegistroHabilidades *registro, MascaraHabilidade mascara) {
+    if (registro->quantidade >= MAX_HABILIDADES) {
+        return -1;
+    }
+
+    int id = registro->quantidade++;
+    MascaraHabilidade *variantes = registro->variantes[id];
+    variantes[VARIANTE_ORIGINAL] = mascara;
+    variantes[VARIANTE_ESPELHADA] = espelharHabilidade(mascara);
+    for (int giro = 1; giro < 4; giro++) {
+        variantes[VARIANTE_ORIGINAL + giro] = rotacionarHabilidade(variantes[VARIANTE_ORIGINAL + giro - 1]);
+        variantes[VARIANTE_ESPELHADA + giro] = rotacionarHabilidade(variantes[VARIANTE_ESPELHADA + giro - 1]);
+    }
+    return id;
+}
+
+// Função para iniciar um registro com as formas padrão (cone, cruz e octaedro)
+// Os ids das formas padrão são os valores de IdHabilidade.
+void iniciarRegistroHabilidades(RegistroHabilidades *registro) {
+    registro->quantidade = 0;
+    registrarHabilidade(registro, MASCARA_CONE);
+    registrarHabilidade(registro, MASCARA_CRUZ);
+    registrarHabilidade(registro, MASCARA_OCTAEDRO);
+}
+
+// Implementação de referência de aplicarHabilidadeAoTabuleiro (célula a célula)
+// Mantida para conferir as versões otimizadas no modo "verificar".
+void aplicarHabilidadeAoTabuleiroReferencia(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                                            int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO],
+                                            int origin_row, int origin_col) {
+    int r_hab, c_hab; // Coordenadas na matriz de habilidade
+    int r_tab, c_tab; // Coordenadas correspondentes no tabuleiro principal
+
+    // Itera sobre a matriz de habilidade
+    for (r_hab = 0; r_hab < HABILIDADE_TAMANHO; r_hab++) {
+        for (c_hab = 0; c_hab < HABILIDADE_TAMANHO; c_hab++) {
+            // Se a célula na matriz de habilidade é afetada (valor 1)
+            if (matriz_habilidade[r_hab][c_hab] == 1) {
+                // Calcula a coordenada correspondente no tabuleiro principal,
+                // centrando a habilidade no ponto de origem.
+                r_tab = origin_row + (r_hab - HABILIDADE_CENTRO);
+                c_tab = origin_col + (c_hab - HABILIDADE_CENTRO);
+
+                // --- Validação de Limites ---
+                // Verifica se a posição calculada está dentro dos limites do tabuleiro principal
+                if (r_tab >= 0 && r_tab < TABULEIRO_TAMANHO &&
+                    c_tab >= 0 && c_tab < TABULEIRO_TAMANHO) {
+                    // --- Sobreposição da Habilidade ---
+                    // Se a posição no tabuleiro principal é água (0), marca como área de habilidade (5).
+                    // Navios (3) permanecem como navios, não são sobrescritos por habilidades visuais neste nível.
+                    if (tabuleiro[r_tab][c_tab] == VALOR_AGUA) {
+                        tabuleiro[r_tab][c_tab] = VALOR_HABILIDADE;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// --- Tabuleiro com Registro de Desfazer ---
+// As alterações de placeShip e das habilidades são anotadas (célula, valor anterior)
+// somente quando o valor muda. Um instantâneo é só o tamanho atual do registro, e
+// voltar a ele restaura apenas as células alteradas depois, em ordem inversa.
+
+// Função para iniciar o tabuleiro com água e o registro vazio
+void iniciarTabuleiroDesfazer(TabuleiroDesfazer *tabuleiro) {
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            tabuleiro->celulas[r][c] = VALOR_AGUA;
+        }
+    }
+    tabuleiro->quantidade = 0;
+}
+
+// Função para desfazer todas as alterações feitas depois do instantâneo 'ponto'
+// Instantâneos podem ser aninhados: voltar a um ponto anterior invalida os posteriores.
+void restaurarTabuleiro(TabuleiroDesfazer *tabuleiro, PontoRestauracao ponto) {
+    int *celulas = &tabuleiro->celulas[0][0];
+    while (tabuleiro->quantidade > ponto) {
+        const AlteracaoCelula *alteracao = &tabuleiro->registro[--tabuleiro->quantidade];
+        celulas[alteracao->celula] = alteracao->valor_anterior;
+    }
+}
+
+// Versão com registro de placeShip (mesmas pré-condições: canPlaceShip já confirmou)
+void placeShipDesfazer(TabuleiroDesfazer *tabuleiro,
+                       int start_row, int start_col, int size, OrientacaoNavio orientation) {
+    INSTRUMENTAR_INICIO();
+    Bitboard mascara = mascaraNavio(start_row, start_col, size, orientation) & ~BITBOARD_GUARDA;
+    while (mascara) {
+        alterarCelula(tabuleiro, extrairCelula(&mascara), VALOR_NAVIO);
+    }
+    INSTRUMENTAR_FIM(OP_PLACE_SHIP_DESFAZER);
+}
+
+// Versão com registro de aplicarMascaraHabilidade: água coberta vira habilidade
+// Sem desvio por célula: a entrada é sempre escrita no fim do registro (há uma posição
+// de folga) e só é mantida, avançando 'quantidade', quando a célula era água.
+void aplicarMascaraHabilidadeDesfazer(TabuleiroDesfazer *tabuleiro, MascaraHabilidade mascara,
+                                      int origin_row, int origin_col) {
+    Bitboard carimbo = carimboHabilidade(mascara, origin_row, origin_col);
+    int *celulas = &tabuleiro->celulas[0][0];
+    int quantidade = tabuleiro->quantidade;
+
+    for (int metade = 0; metade < 2; metade++) {
+        uint64_t bits = (uint64_t)(carimbo >> (64 * metade));
+        while (bits) {
+            int celula = 64 * metade + __builtin_ctzll(bits);
+            int anterior = celulas[celula];
+            int agua = anterior == VALOR_AGUA;
+            bits &= bits - 1;
+            tabuleiro->registro[quantidade].celula = (uint8_t)celula;
+            tabuleiro->registro[quantidade].valor_anterior = anterior;
+            quantidade += agua;
+            celulas[celula] = agua ? VALOR_HABILIDADE : anterior;
+        }
+    }
+    tabuleiro->quantidade = quantidade;
+}
+
+// Versão com registro de aplicarHabilidadeAoTabuleiro
+void aplicarHabilidadeAoTabuleiroDesfazer(TabuleiroDesfazer *tabuleiro,
+                                         int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO],
+                                         int origin_row, int origin_col) {
+    INSTRUMENTAR_INICIO();
+    aplicarMascaraHabilidadeDesfazer(tabuleiro, compactarHabilidade(matriz_habilidade), origin_row, origin_col);
+    INSTRUMENTAR_FIM(OP_APLICAR_HABILIDADE_DESFAZER);
+}
+
+// --- Gerador Aleatório de Frotas ---
+
+// Função para iniciar o gerador pseudoaleatório a partir de uma semente
+// A mesma semente sempre produz a mesma sequência de números.
+void semearGerador(GeradorAleatorio *gerador, uint64_t semente) {
+    for (int i = 0; i < 4; i++) {
+        gerador->s[i] = splitmix64(&semente);
+    }
+}
+
+// Função para obter um posicionamento pelo índice global (o mesmo guardado em Frota)
+const PosicionamentoNavio *posicionamentoPorIndice(int indice) {
+    return &posicionamentos[indice];
+}
+
+// Função para validar uma configuração de frota
+// Retorna true se a quantidade de navios e todos os tamanhos são aceitos pelo gerador.
+bool configuracaoFrotaValida(const ConfiguracaoFrota *config) {
+    if (config->quantidade_navios < 0 || config->quantidade_navios > MAX_NAVIOS_FROTA) {
+        return false;
+    }
+    for (int i = 0; i < config->quantidade_navios; i++) {
+        if (config->tamanhos[i] < 1 || config->tamanhos[i] > TABULEIRO_TAMANHO) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Função para gerar uma frota aleatória válida
+// Para cada tamanho de navio da frota é mantido o conjunto (bitset) dos posicionamentos
+// ainda livres; cada navio é sorteado uniformemente nesse conjunto (sem rejeição) e, ao ser
+// posicionado, remove do conjunto de todos os tamanhos os posicionamentos que cobrem suas células.
+// Se algum navio não tiver mais posicionamento possível, a frota é recomeçada.
+// Retorna false se a frota não pôde ser gerada após MAX_TENTATIVAS_FROTA recomeços.
+#define MAX_TENTATIVAS_FROTA 1000
+bool gerarFrota(GeradorAleatorio *gerador, const ConfiguracaoFrota *config, Frota *frota) {
+    uint64_t livres[TABULEIRO_TAMANHO][PALAVRAS_POSICIONAMENTOS]; // Candidatos por tamanho
+    int tamanhos_usados[MAX_NAVIOS_FROTA];                        // Tamanhos distintos da frota
+    int num_tamanhos = 0;
+
+    for (int i = 0; i < config->quantidade_navios; i++) {
+        bool repetido = false;
+        for (int j = 0; j < num_tamanhos; j++) {
+            repetido |= tamanhos_usados[j] == config->tamanhos[i];
+        }
+        if (!repetido) {
+            tamanhos_usados[num_tamanhos++] = config->tamanhos[i];
+        }
+    }
+
+    for (int tentativa = 0; tentativa < MAX_TENTATIVAS_FROTA; tentativa++) {
+        Bitboard navios = 0;
+        int navio;
+
+        // Todos os posicionamentos legais de cada tamanho começam livres
+        for (int t = 0; t < num_tamanhos; t++) {
+            int size = tamanhos_usados[t];
+            int quantidade = inicio_posicionamentos[size + 1] - inicio_posicionamentos[size];
+            for (int w = 0; w < PALAVRAS_POSICIONAMENTOS; w++) {
+                int bits = quantidade - w * 64;
+                livres[size - 1][w] = bits >= 64 ? ~0ULL : bits > 0 ? (1ULL << bits) - 1 : 0;
+            }
+        }
+
+        for (navio = 0; navio < config->quantidade_navios; navio++) {
+            int size = config->tamanhos[navio];
+            uint64_t *candidatos = livres[size - 1];
+            int n = 0;
+
+            for (int w = 0; w < PALAVRAS_POSICIONAMENTOS; w++) {
+                n += __builtin_popcountll(candidatos[w]);
+            }
+            if (n == 0) {
+                break; // Beco sem saída: recomeça a frota
+            }
+
+            // Sorteia o ordem-ésimo candidato livre
+            int ordem = (int)aleatorioAte(gerador, (uint32_t)n);
+            int w = 0;
+            while (ordem >= __builtin_popcountll(candidatos[w])) {
+                ordem -= __builtin_popcountll(candidatos[w]);
+                w++;
+            }
+            int indice = inicio_posicionamentos[size] + w * 64 + selecionarBit(candidatos[w], ordem);
+            Bitboard mascara = posicionamentoPorIndice(indice)->mascara;
+
+            navios |= mascara;
+            frota->posicionamento[navio] = (uint16_t)indice;
+
+            // Remove os posicionamentos que agora se sobrepõem ao navio
+            while (mascara) {
+                int celula = extrairCelula(&mascara);
+                for (int t = 0; t < num_tamanhos; t++) {
+                    int s = tamanhos_usados[t] - 1;
+                    for (int k = 0; k < PALAVRAS_POSICIONAMENTOS; k++) {
+                        livres[s][k] &= ~cobertura_posicionamentos[s][celula][k];
+                    }
+                }
+            }
+        }
+
+        if (navio == config->quantidade_navios) {
+            frota->navios = navios;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Função para gerar um lote de frotas aleatórias no buffer 'saida'
+// Retorna quantas frotas foram geradas (menos que 'quantidade' apenas se a
+// configuração for inválida ou impossível de posicionar).
+int gerarFrotas(GeradorAleatorio *gerador, const ConfiguracaoFrota *config, Frota saida[], int quantidade) {
+    if (!configuracaoFrotaValida(config)) {
+        return 0;
+    }
+    for (int i = 0; i < quantidade; i++) {
+        if (!gerarFrota(gerador, config, &saida[i])) {
+            return i;
+        }
+    }
+    return quantidade;
+}
+
+// Função para posicionar uma frota gerada em um tabuleiro de inteiros (já inicializado)
+// Usa canPlaceShip/placeShip, de modo que o resultado é validado pela implementação original.
+// Retorna false se algum navio não puder ser posicionado.
+bool posicionarFrota(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                     const Frota *frota, const ConfiguracaoFrota *config) {
+    for (int i = 0; i < config->quantidade_navios; i++) {
+        const PosicionamentoNavio *p = posicionamentoPorIndice(frota->posicionamento[i]);
+        OrientacaoNavio orientacao = (OrientacaoNavio)p->orientacao;
+        if (!canPlaceShip(tabuleiro, p->linha, p->coluna, p->tamanho, orientacao)) {
+            return false;
+        }
+        placeShip(tabuleiro, p->linha, p->coluna, p->tamanho, orientacao);
+    }
+    return true;
+}
+
+// --- Simulação de Monte Carlo de Acertos das Habilidades ---
+// Estima, para cada forma e cada origem, quantas células de navio a habilidade atinge em média
+// sobre frotas aleatórias. As frotas são divididas em blocos de BLOCO_SIMULACAO; as threads
+// pegam o próximo bloco livre de um contador atômico (quem termina antes pega mais blocos),
+// acumulam em contadores locais e só no final somam ao resultado com adições atômicas.
+// Cada bloco tem um gerador semeado por (semente, número do bloco), então o resultado
+// depende apenas da semente, e não do número de threads.
+
+// Estado compartilhado entre as threads de uma simulação
+typedef struct {
+    const ConfiguracaoSimulacao *config;
+    Bitboard carimbos[MAX_FORMAS_SIMULACAO][TABULEIRO_CELULAS]; // Carimbo de cada forma em cada origem
+    long long total_blocos;
+    atomic_llong proximo_bloco;
+    atomic_llong frotas;
+    atomic_uint_least64_t acertos[MAX_FORMAS_SIMULACAO][TABULEIRO_CELULAS];
+    atomic_bool falhou; // Configuração de frota impossível de posicionar
+} EstadoSimulacao;
+
+// Função executada por cada thread da simulação
+static void *trabalhadorSimulacao(void *argumento) {
+    EstadoSimulacao *estado = argumento;
+    const ConfiguracaoSimulacao *config = estado->config;
+    uint64_t acertos[MAX_FORMAS_SIMULACAO][TABULEIRO_CELULAS] = {{0}};
+    long long frotas = 0;
+    long long bloco;
+
+    while ((bloco = atomic_fetch_add(&estado->proximo_bloco, 1)) < estado->total_blocos) {
+        GeradorAleatorio gerador;
+        long long inicio = bloco * BLOCO_SIMULACAO;
+        long long fim = MINIMO(inicio + BLOCO_SIMULACAO, config->frotas);
+
+        semearGerador(&gerador, config->semente ^ ((uint64_t)bloco * 0xD1B54A32D192ED03ULL));
+        for (long long i = inicio; i < fim; i++) {
+            Frota frota;
+            if (!gerarFrota(&gerador, &config->frota, &frota)) {
+                atomic_store(&estado->falhou, true);
+                return NULL;
+            }
+            for (int f = 0; f < config->num_formas; f++) {
+                for (int origem = 0; origem < TABULEIRO_CELULAS; origem++) {
+                    acertos[f][origem] += (uint64_t)contarBits(estado->carimbos[f][origem] & frota.navios);
+                }
+            }
+        }
+        frotas += fim - inicio;
+    }
+
+    // Junção sem trava: cada contador recebe uma única adição atômica por thread
+    for (int f = 0; f < config->num_formas; f++) {
+        for (int origem = 0; origem < TABULEIRO_CELULAS; origem++) {
+            atomic_fetch_add_explicit(&estado->acertos[f][origem], acertos[f][origem], memory_order_relaxed);
+        }
+    }
+    atomic_fetch_add(&estado->frotas, frotas);
+    return NULL;
+}
+
+// Função para executar a simulação em 'config->threads' threads
+// Retorna false se a configuração for inválida, a frota for impossível ou faltar memória.
+bool simularHabilidades(const ConfiguracaoSimulacao *config, ResultadoSimulacao *resultado) {
+    if (config->threads < 1 || config->frotas < 0 || config->num_formas < 0 ||
+        config->num_formas > MAX_FORMAS_SIMULACAO || !configuracaoFrotaValida(&config->frota)) {
+        return false;
+    }
+
+    EstadoSimulacao *estado = malloc(sizeof(EstadoSimulacao));
+    pthread_t *threads = malloc((size_t)config->threads * sizeof(pthread_t));
+    if (estado == NULL || threads == NULL) {
+        free(estado);
+        free(threads);
+        return false;
+    }
+
+    estado->config = config;
+    estado->total_blocos = (config->frotas + BLOCO_SIMULACAO - 1) / BLOCO_SIMULACAO;
+    atomic_init(&estado->proximo_bloco, 0);
+    atomic_init(&estado->frotas, 0);
+    atomic_init(&estado->falhou, false);
+    for (int f = 0; f < MAX_FORMAS_SIMULACAO; f++) {
+        for (int origem = 0; origem < TABULEIRO_CELULAS; origem++) {
+            atomic_init(&estado->acertos[f][origem], 0);
+            estado->carimbos[f][origem] = f < config->num_formas
+                ? carimboHabilidade(config->formas[f], origem / TABULEIRO_TAMANHO, origem % TABULEIRO_TAMANHO)
+                : 0;
+        }
+    }
+
+    // A thread atual também trabalha; as demais são criadas aqui
+    int criadas = 0;
+    while (criadas < config->threads - 1 &&
+           pthread_create(&threads[criadas], NULL, trabalhadorSimulacao, estado) == 0) {
+        criadas++;
+    }
+    trabalhadorSimulacao(estado);
+    for (int i = 0; i < criadas; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    bool sucesso = !atomic_load(&estado->falhou);
+    resultado->frotas = atomic_load(&estado->frotas);
+    for (int f = 0; f < MAX_FORMAS_SIMULACAO; f++) {
+        for (int origem = 0; origem < TABULEIRO_CELULAS; origem++) {
+            resultado->acertos[f][origem] = atomic_load(&estado->acertos[f][origem]);
+        }
+    }
+    free(threads);
+    free(estado);
+    return sucesso;
+}
+
+// --- Solver de Tiros por Densidade de Probabilidade ---
+// Para cada célula, a densidade é quantos posicionamentos legais ainda podem cobri-la,
+// ponderados pelo número de navios daquele tamanho ainda no mar. Um tiro na água invalida os
+// posicionamentos que cobrem a célula; um acerto aumenta o peso "alvo" dos posicionamentos
+// que passam por ela. Nos dois casos só os posicionamentos que cobrem a célula do tiro são
+// visitados (pelos conjuntos de cobertura), em vez de recalcular o tabuleiro inteiro.
+// As contagens ficam separadas por tamanho e também somadas com os pesos (total e total_alvo);
+// afundar um navio muda o peso do tamanho e os totais são refeitos a partir das contagens.
+
+// Função auxiliar para somar 'delta' às contagens das células de um posicionamento
+// e 'delta * peso' aos totais correspondentes
+static inline void somarDensidade(int32_t densidade[], int32_t total[], const PosicionamentoNavio *p,
+                                  int32_t delta, int32_t peso) {
+    int celula = p->celula;
+    for (int i = 0; i < p->tamanho; i++, celula += p->passo) {
+        densidade[celula] += delta;
+        total[celula] += delta * peso;
+    }
+}
+
+// Função auxiliar para refazer os totais ponderados a partir das contagens por tamanho
+static void recalcularTotais(SolverTiros *solver) {
+    memset(solver->total, 0, sizeof(solver->total));
+    memset(solver->total_alvo, 0, sizeof(solver->total_alvo));
+    for (int t = 0; t < solver->num_tamanhos; t++) {
+        for (int celula = 0; celula < TABULEIRO_CELULAS; celula++) {
+            solver->total[celula] += solver->peso[t] * solver->densidade[t][celula];
+            solver->total_alvo[celula] += solver->peso[t] * solver->densidade_alvo[t][celula];
+        }
+    }
+}
+
+// Função auxiliar para atualizar os posicionamentos válidos do t-ésimo tamanho que cobrem 'celula'
+// invalidar: true para tiro na água ou navio afundado, false para registrar um acerto
+static void atualizarCobertura(SolverTiros *solver, int t, int celula, bool invalidar) {
+    int size = solver->tamanhos[t];
+    uint64_t *validos = solver->validos[t];
+    const uint64_t *cobertura = cobertura_posicionamentos[size - 1][celula];
+    const PosicionamentoNavio *tabela = &posicionamentos[inicio_posicionamentos[size]];
+    uint8_t *acertos_cobertos = &solver->acertos_cobertos[inicio_posicionamentos[size]];
+    int32_t peso = solver->peso[t];
+
+    for (int w = 0; w < PALAVRAS_POSICIONAMENTOS; w++) {
+        uint64_t afetados = validos[w] & cobertura[w];
+        if (invalidar) {
+            validos[w] &= ~afetados;
+        }
+        while (afetados) {
+            int relativo = w * 64 + __builtin_ctzll(afetados);
+            afetados &= afetados - 1;
+
+            if (invalidar) {
+                somarDensidade(solver->densidade[t], solver->total, &tabela[relativo], -1, peso);
+                somarDensidade(solver->densidade_alvo[t], solver->total_alvo, &tabela[relativo],
+                               -acertos_cobertos[relativo], peso);
+            } else {
+                acertos_cobertos[relativo]++;
+                somarDensidade(solver->densidade_alvo[t], solver->total_alvo, &tabela[relativo], 1, peso);
+            }
+        }
+    }
+}
+
+// Função para iniciar o solver para uma frota com a configuração dada (tabuleiro sem tiros)
+void iniciarSolver(SolverTiros *solver, const ConfiguracaoFrota *config) {
+    solver->tiros = 0;
+    solver->acertos = 0;
+    solver->afundados = 0;
+    memset(solver->livre, 0xFF, sizeof(solver->livre));
+    solver->num_tamanhos = 0;
+    for (int i = 0; i < config->quantidade_navios; i++) {
+        int t = 0;
+        while (t < solver->num_tamanhos && solver->tamanhos[t] != config->tamanhos[i]) {
+            t++;
+        }
+        if (t == solver->num_tamanhos) {
+            solver->tamanhos[solver->num_tamanhos++] = config->tamanhos[i];
+            solver->peso[t] = 0;
+        }
+        solver->peso[t]++;
+    }
+
+    // Contagem inicial: todos os posicionamentos legais (os mesmos aceitos por canPlaceShip)
+    for (int t = 0; t < solver->num_tamanhos; t++) {
+        int size = solver->tamanhos[t];
+        int quantidade = inicio_posicionamentos[size + 1] - inicio_posicionamentos[size];
+
+        memset(solver->validos[t], 0, sizeof(solver->validos[t]));
+        memset(solver->densidade[t], 0, sizeof(solver->densidade[t]));
+        memset(solver->densidade_alvo[t], 0, sizeof(solver->densidade_alvo[t]));
+        memset(&solver->acertos_cobertos[inicio_posicionamentos[size]], 0, (size_t)quantidade);
+        for (int relativo = 0; relativo < quantidade; relativo++) {
+            const PosicionamentoNavio *p = &posicionamentos[inicio_posicionamentos[size] + relativo];
+            solver->validos[t][relativo / 64] |= 1ULL << (relativo % 64);
+            for (int i = 0, celula = p->celula; i < p->tamanho; i++, celula += p->passo) {
+                solver->densidade[t][celula]++;
+            }
+        }
+    }
+    recalcularTotais(solver); // Os totais ponderados saem das contagens acima
+}
+
+// Função para registrar o resultado de um tiro na célula (row, col)
+void registrarTiro(SolverTiros *solver, int row, int col, bool acertou) {
+    int celula = row * TABULEIRO_TAMANHO + col;
+    Bitboard bit = (Bitboard)1 << celula;
+
+    if (solver->tiros & bit) {
+        return; // Tiro repetido não traz informação nova
+    }
+    solver->tiros |= bit;
+    solver->livre[celula] = 0;
+    if (acertou) {
+        solver->acertos |= bit;
+    }
+    for (int t = 0; t < solver->num_tamanhos; t++) {
+        atualizarCobertura(solver, t, celula, !acertou);
+    }
+}
+
+// Função para registrar que o navio no posicionamento 'indice' (global) foi afundado
+// Suas células deixam de servir para outros navios e o peso do seu tamanho diminui.
+void registrarAfundado(SolverTiros *solver, int indice) {
+    const PosicionamentoNavio *navio = &posicionamentos[indice];
+    int celula = navio->celula;
+
+    solver->afundados |= navio->mascara;
+    for (int i = 0; i < navio->tamanho; i++, celula += navio->passo) {
+        for (int t = 0; t < solver->num_tamanhos; t++) {
+            atualizarCobertura(solver, t, celula, true);
+        }
+    }
+    for (int t = 0; t < solver->num_tamanhos; t++) {
+        if (solver->tamanhos[t] == navio->tamanho && solver->peso[t] > 0) {
+            solver->peso[t]--;
+        }
+    }
+    recalcularTotais(solver);
+}
+
+// Função para escolher o próximo tiro
+// Se algum acerto ainda não pertence a um navio afundado, atira na célula livre com maior
+// densidade "alvo" (caça ao navio atingido); senão, na de maior densidade geral.
+// Retorna o índice da célula, ou -1 se todas já foram atiradas.
+int escolherTiro(const SolverTiros *solver) {
+    int melhor = -1;
+    uint64_t melhor_valor = 0;
+
+    // A densidade alvo fica nos 32 bits altos (domina) e a geral nos baixos (só desempata).
+    // Células já atiradas valem 0; as livres valem pelo menos 1. Em empate fica a de menor índice.
+    for (int celula = 0; celula < TABULEIRO_CELULAS; celula++) {
+        uint64_t v = ((((uint64_t)(uint32_t)solver->total_alvo[celula] << 32) |
+                       (uint32_t)solver->total[celula]) + 1) & solver->livre[celula];
+        bool maior = v > melhor_valor;
+        melhor_valor = maior ? v : melhor_valor;
+        melhor = maior ? celula : melhor;
+    }
+    return melhor;
+}
+
+// Função para jogar uma partida completa do solver contra uma frota
+// Retorna o número de tiros até afundar todos os navios.
+int jogarPartidaSolver(SolverTiros *solver, const Frota *frota, const ConfiguracaoFrota *config) {
+    Bitboard restantes[MAX_NAVIOS_FROTA]; // Células ainda não atingidas de cada navio
+    int navios_no_mar = config->quantidade_navios;
+    int tiros = 0;
+
+    iniciarSolver(solver, config);
+    for (int i = 0; i < config->quantidade_navios; i++) {
+        restantes[i] = posicionamentos[frota->posicionamento[i]].mascara;
+    }
+
+    while (navios_no_mar > 0) {
+        int celula = escolherTiro(solver);
+        Bitboard bit = (Bitboard)1 << celula;
+        bool acertou = (frota->navios & bit) != 0;
+
+        tiros++;
+        registrarTiro(solver, celula / TABULEIRO_TAMANHO, celula % TABULEIRO_TAMANHO, acertou);
+        if (!acertou) {
+            continue;
+        }
+        for (int i = 0; i < config->quantidade_navios; i++) {
+            if (restantes[i] & bit) {
+                restantes[i] &= ~bit;
+                if (restantes[i] == 0) {
+                    registrarAfundado(solver, frota->posicionamento[i]);
+                    navios_no_mar--;
+                }
+            }
+        }
+    }
+    return tiros;
+}
+
+// --- Avaliação de Habilidades em Todas as Origens ---
+// Em vez de copiar o tabuleiro, aplicar a habilidade e varrer o resultado para cada uma das
+// 100 origens, os carimbos da forma são calculados uma vez (tabela por origem) e cada origem
+// custa duas interseções de bitboards com contagem de bits. O tabuleiro não é alterado.
+
+// Função para preparar a tabela de carimbos de uma forma de habilidade
+void prepararCarimbos(TabelaCarimbos *tabela, MascaraHabilidade mascara) {
+    for (int origem = 0; origem < TABULEIRO_CELULAS; origem++) {
+        tabela->carimbo[origem] = carimboHabilidade(mascara, origem / TABULEIRO_TAMANHO, origem % TABULEIRO_TAMANHO);
+    }
+}
+
+// Função para avaliar todas as origens sobre um tabuleiro em bitboard
+// Água é toda célula não ocupada (nem navio, nem habilidade, nem outro valor).
+void avaliarOrigensBits(const TabuleiroBits *tabuleiro, const TabelaCarimbos *tabela, AvaliacaoOrigens *avaliacao) {
+    Bitboard navios = tabuleiro->navios;
+    Bitboard agua = ~tabuleiro->ocupadas; // A guarda está sempre em 'ocupadas'
+
+    for (int origem = 0; origem < TABULEIRO_CELULAS; origem++) {
+        avaliacao->navios[origem] = (uint8_t)contarBits(tabela->carimbo[origem] & navios);
+        avaliacao->agua[origem] = (uint8_t)contarBits(tabela->carimbo[origem] & agua);
+    }
+}
+
+// Função para avaliar todas as origens sobre o tabuleiro de inteiros
+// Mesmo resultado que aplicar a habilidade em uma cópia do tabuleiro para cada origem e
+// contar as células de água que mudaram e as de navio cobertas.
+void avaliarOrigensHabilidade(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO], const TabelaCarimbos *tabela,
+                              AvaliacaoOrigens *avaliacao) {
+    TabuleiroBits bits;
+    matrizParaBitboard(tabuleiro, &bits);
+    avaliarOrigensBits(&bits, tabela, avaliacao);
+}
+
+// Versão de referência: uma cópia do tabuleiro por origem, aplicação com
+// aplicarHabilidadeAoTabuleiro e varredura das 100 células. As células de navio cobertas
+// são obtidas aplicando a habilidade a uma segunda cópia em que só os navios são água.
+void avaliarOrigensReferencia(int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO],
+                              int matriz_habilidade[HABILIDADE_TAMANHO][HABILIDADE_TAMANHO],
+                              AvaliacaoOrigens *avaliacao) {
+    int so_navios[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            so_navios[r][c] = tabuleiro[r][c] == VALOR_NAVIO ? VALOR_AGUA : VALOR_NAVIO;
+        }
+    }
+
+    for (int origem = 0; origem < TABULEIRO_CELULAS; origem++) {
+        int copia[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+        int copia_navios[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO];
+        int agua = 0, navios = 0;
+
+        memcpy(copia, tabuleiro, sizeof(copia));
+        memcpy(copia_navios, so_navios, sizeof(copia_navios));
+        aplicarHabilidadeAoTabuleiro(copia, matriz_habilidade, origem / TABULEIRO_TAMANHO, origem % TABULEIRO_TAMANHO);
+        aplicarHabilidadeAoTabuleiro(copia_navios, matriz_habilidade, origem / TABULEIRO_TAMANHO,
+                                     origem % TABULEIRO_TAMANHO);
+        for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+            for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+                agua += copia[r][c] != tabuleiro[r][c];
+                navios += copia_navios[r][c] != so_navios[r][c];
+            }
+        }
+        avaliacao->navios[origem] = (uint8_t)navios;
+        avaliacao->agua[origem] = (uint8_t)agua;
+    }
+}
+
+// --- Modo de Acumulação de Habilidades ---
+// aplicarHabilidadeAoTabuleiro só marca água, então habilidades sobrepostas e navios
+// atingidos se perdem. A camada de intensidade guarda, sem alterar o tabuleiro, quantas
+// habilidades cobriram cada célula e quais células de navio foram atingidas.
+
+// Função para iniciar a camada de intensidade com os navios de um tabuleiro
+void iniciarCamadaIntensidade(CamadaIntensidade *camada, int tabuleiro[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]) {
+    TabuleiroBits bits;
+    matrizParaBitboard(tabuleiro, &bits);
+    memset(camada->planos, 0, sizeof(camada->planos));
+    camada->navios = bits.navios;
+    camada->navios_atingidos = 0;
+    camada->habilidades = 0;
+}
+
+// Função para acumular uma habilidade com origem em (origin_row, origin_col)
+void acumularHabilidade(CamadaIntensidade *camada, MascaraHabilidade mascara, int origin_row, int origin_col) {
+    acumularCarimbo(camada, carimboHabilidade(mascara, origin_row, origin_col));
+}
+
+// Função para acumular uma sequência de habilidades de uma mesma forma
+// 'origens' são índices de célula (linha * TABULEIRO_TAMANHO + coluna) na tabela de carimbos.
+void acumularHabilidades(CamadaIntensidade *camada, const TabelaCarimbos *tabela, const uint8_t origens[],
+                         int quantidade) {
+    for (int i = 0; i < quantidade; i++) {
+        acumularCarimbo(camada, tabela->carimbo[origens[i]]);
+    }
+}
+
+// Função para copiar os contadores da camada para uma matriz de inteiros
+void camadaParaMatriz(const CamadaIntensidade *camada, int intensidade[TABULEIRO_TAMANHO][TABULEIRO_TAMANHO]) {
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            intensidade[r][c] = intensidadeCelula(camada, r * TABULEIRO_TAMANHO + c);
+        }
+    }
+}
+
+// Função para renderizar a camada de intensidade como mapa de calor (mesma moldura do
+// formato completo): '~' célula não atingida, '1' a '9' quantas habilidades a cobriram,
+// '+' dez ou mais, 'N' navio não atingido e 'X' navio atingido
+// 'destino' deve ter RENDERIZACAO_MAX_COMPLETO bytes. Retorna a quantidade de bytes escritos.
+size_t renderizarMapaCalor(const CamadaIntensidade *camada, char *destino) {
+    char *p = escreverCabecalho(destino);
+
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        p = escreverInteiro(p, r);
+        *p++ = ' ';
+        *p++ = '|';
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            int celula = r * TABULEIRO_TAMANHO + c;
+            int valor = intensidadeCelula(camada, celula);
+            if ((camada->navios >> celula) & 1) {
+                *p++ = valor > 0 ? 'X' : 'N';
+            } else {
+                *p++ = valor == 0 ? '~' : valor <= 9 ? (char)('0' + valor) : '+';
+            }
+            *p++ = ' ';
+        }
+        *p++ = '|';
+        *p++ = '\n';
+    }
+    p = escreverSeparador(p);
+    *p++ = '\n';
+    return (size_t)(p - destino);
+}
+
+// --- Enumeração Exaustiva de Frotas ---
+// Conta (e opcionalmente grava) todas as frotas de K navios de um mesmo tamanho, em todas
+// as orientações. A busca é um backtracking sobre conjuntos de bits: os candidatos de cada
+// nível são os do nível anterior & compativeis[p], que já exclui sobreposições e índices
+// menores (cada frota é gerada uma única vez, em ordem crescente); o último nível é contado
+// por popcount. A árvore é dividida em tarefas (p0, p1) distribuídas por um contador atômico.
+// As 8 simetrias do tabuleiro permutam os posicionamentos; o número de frotas distintas a
+// menos de simetria vem do lema de Burnside, e a gravação percorre apenas frotas canônicas
+// (a menor, em ordem lexicográfica de índices, entre as 8 imagens).
+
+// Função para aplicar uma simetria a uma célula (0 identidade, 1-3 rotações de 90, 180 e
+// 270 graus, 4 espelho horizontal, 5 transposição, 6 espelho vertical, 7 antitransposição)
+static void transformarCelula(int simetria, int *linha, int *coluna) {
+    const int m = TABULEIRO_TAMANHO - 1;
+    int r = *linha, c = *coluna;
+    switch (simetria) {
+        case 1: *linha = c;     *coluna = m - r; break;
+        case 2: *linha = m - r; *coluna = m - c; break;
+        case 3: *linha = m - c; *coluna = r;     break;
+        case 4: *linha = r;     *coluna = m - c; break;
+        case 5: *linha = c;     *coluna = r;     break;
+        case 6: *linha = m - r; *coluna = c;     break;
+        case 7: *linha = m - c; *coluna = m - r; break;
+        default: break;
+    }
+}
+
+// Função para preparar as tabelas de enumeração de navios de tamanho 'size'
+// Tamanho 1 não é aceito: as quatro orientações geram a mesma célula.
+bool prepararEnumeracao(TabelasEnumeracao *tabelas, int size) {
+    if (size < 2 || size > TABULEIRO_TAMANHO) {
+        return false;
+    }
+    const PosicionamentoNavio *base = posicionamentosDoTamanho(size, &tabelas->quantidade);
+    tabelas->tamanho = size;
+    tabelas->primeiro = (int)(base - posicionamentos);
+    memset(tabelas->compativeis, 0, sizeof(tabelas->compativeis));
+    memset(tabelas->acima_orbita, 0, sizeof(tabelas->acima_orbita));
+
+    for (int p = 0; p < tabelas->quantidade; p++) {
+        for (int q = p + 1; q < tabelas->quantidade; q++) {
+            if ((base[p].mascara & base[q].mascara) == 0) {
+                tabelas->compativeis[p].palavras[q / 64] |= 1ULL << (q % 64);
+            }
+        }
+    }
+
+    // Imagem de cada posicionamento: o posicionamento com a máscara transformada
+    // (a máscara identifica o posicionamento, pois há uma orientação por direção)
+    uint16_t minimo_orbita[MAX_POSICIONAMENTOS_TAMANHO];
+    for (int p = 0; p < tabelas->quantidade; p++) {
+        minimo_orbita[p] = (uint16_t)p;
+        for (int g = 0; g < NUM_SIMETRIAS; g++) {
+            Bitboard imagem = 0, mascara = base[p].mascara;
+            while (mascara) {
+                int celula = extrairCelula(&mascara);
+                int r = celula / TABULEIRO_TAMANHO, c = celula % TABULEIRO_TAMANHO;
+                transformarCelula(g, &r, &c);
+                imagem |= BITBOARD_CELULA(r, c);
+            }
+            int q = 0;
+            while (base[q].mascara != imagem) {
+                q++;
+            }
+            tabelas->simetria[g][p] = (uint16_t)q;
+            minimo_orbita[p] = (uint16_t)MINIMO(minimo_orbita[p], q);
+        }
+    }
+    for (int p = 0; p < tabelas->quantidade; p++) {
+        for (int q = 0; q < tabelas->quantidade; q++) {
+            if (minimo_orbita[q] >= p) {
+                tabelas->acima_orbita[p].palavras[q / 64] |= 1ULL << (q % 64);
+            }
+        }
+    }
+    return true;
+}
+
+// Função auxiliar para a interseção de dois conjuntos de posicionamentos
+static inline void intersectarPosicionamentos(ConjuntoPosicionamentos *destino, const ConjuntoPosicionamentos *a,
+                                              const ConjuntoPosicionamentos *b) {
+    for (int w = 0; w < PALAVRAS_POSICIONAMENTOS; w++) {
+        destino->palavras[w] = a->palavras[w] & b->palavras[w];
+    }
+}
+
+// Função auxiliar para testar se um posicionamento pertence ao conjunto
+static inline bool contemPosicionamento(const ConjuntoPosicionamentos *conjunto, int p) {
+    return (conjunto->palavras[p / 64] >> (p % 64)) & 1;
+}
+
+// Função para verificar se uma frota (índices em ordem crescente) é a menor, em ordem
+// lexicográfica, entre as suas imagens pelas simetrias do tabuleiro
+static bool frotaCanonica(const TabelasEnumeracao *tabelas, const uint16_t indices[], int navios) {
+    for (int g = 1; g < NUM_SIMETRIAS; g++) {
+        uint16_t imagem[MAX_NAVIOS_FROTA];
+        for (int i = 0; i < navios; i++) {
+            uint16_t q = tabelas->simetria[g][indices[i]];
+            int j = i;
+            while (j > 0 && imagem[j - 1] > q) { // Ordenação por inserção
+                imagem[j] = imagem[j - 1];
+                j--;
+            }
+            imagem[j] = q;
+        }
+        for (int i = 0; i < navios && imagem[i] <= indices[i]; i++) {
+            if (imagem[i] < indices[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Ciclo de uma simetria sobre os posicionamentos, com navios disjuntos entre si
+typedef struct {
+    Bitboard mascara;
+    int comprimento;
+} CicloSimetria;
+
+// Função auxiliar para contar as escolhas de ciclos disjuntos com 'restantes' navios no total
+static uint64_t contarCiclos(const CicloSimetria ciclos[], int num_ciclos, int inicio, int restantes,
+                             Bitboard ocupadas) {
+    uint64_t total = 0;
+    if (restantes == 0) {
+        return 1;
+    }
+    for (int i = inicio; i < num_ciclos; i++) {
+        if (ciclos[i].comprimento <= restantes && (ciclos[i].mascara & ocupadas) == 0) {
+            total += contarCiclos(ciclos, num_ciclos, i + 1, restantes - ciclos[i].comprimento,
+                                  ocupadas | ciclos[i].mascara);
+        }
+    }
+    return total;
+}
+
+// Função para contar as frotas de 'navios' navios invariantes pela simetria 'g' (g != 0)
+// Uma frota invariante é uma união de ciclos inteiros da permutação dos posicionamentos.
+static uint64_t contarFrotasFixas(const TabelasEnumeracao *tabelas, int g, int navios) {
+    static _Thread_local CicloSimetria ciclos[MAX_POSICIONAMENTOS_TAMANHO];
+    bool visitado[MAX_POSICIONAMENTOS_TAMANHO] = {false};
+    const PosicionamentoNavio *base = &posicionamentos[tabelas->primeiro];
+    int num_ciclos = 0;
+
+    for (int p = 0; p < tabelas->quantidade; p++) {
+        Bitboard mascara = 0;
+        int comprimento = 0, celulas = 0;
+        for (int q = p; !visitado[q]; q = tabelas->simetria[g][q]) {
+            visitado[q] = true;
+            mascara |= base[q].mascara;
+            celulas += tabelas->tamanho;
+            comprimento++;
+        }
+        if (comprimento > 0 && contarBits(mascara) == celulas) {
+            ciclos[num_ciclos].mascara = mascara;
+            ciclos[num_ciclos].comprimento = comprimento;
+            num_ciclos++;
+        }
+    }
+    return contarCiclos(ciclos, num_ciclos, 0, navios, 0);
+}
+
+// Estado compartilhado pelas threads de uma enumeração
+#define LOTE_ENUMERACAO 1024 // Frotas canônicas acumuladas por thread antes de gravar
+typedef struct {
+    const TabelasEnumeracao *tabelas;
+    int navios;
+    bool canonicas;               // false: conta todas as frotas; true: só as canônicas
+    EscritorRegistros *escritor;  // Destino das frotas canônicas (NULL: apenas contar)
+    pthread_mutex_t trava;        // Protege o escritor
+    long long total_tarefas;
+    atomic_llong proxima_tarefa;
+    atomic_uint_fast64_t frotas;
+    atomic_bool falhou;
+} EstadoEnumeracao;
+
+// Estado local de uma thread: frota parcial, contagem e lote de frotas a gravar
+typedef struct {
+    EstadoEnumeracao *estado;
+    uint16_t indices[MAX_NAVIOS_FROTA];
+    uint64_t frotas;
+    int no_lote;
+    Frota lote[LOTE_ENUMERACAO];
+} EnumeradorThread;
+
+// Função auxiliar para gravar o lote de frotas canônicas de uma thread
+static void gravarLoteEnumeracao(EnumeradorThread *enumerador) {
+    EstadoEnumeracao *estado = enumerador->estado;
+    if (estado->escritor != NULL && enumerador->no_lote > 0) {
+        pthread_mutex_lock(&estado->trava);
+        for (int i = 0; i < enumerador->no_lote; i++) {
+            if (!escreverFrota(estado->escritor, &enumerador->lote[i])) {
+                atomic_store(&estado->falhou, true);
+            }
+        }
+        pthread_mutex_unlock(&estado->trava);
+    }
+    enumerador->no_lote = 0;
+}
+
+// Função auxiliar para registrar uma frota completa (modo canônico)
+static void registrarFrotaEnumerada(EnumeradorThread *enumerador) {
+    const EstadoEnumeracao *estado = enumerador->estado;
+    const TabelasEnumeracao *tabelas = estado->tabelas;
+
+    if (!frotaCanonica(tabelas, enumerador->indices, estado->navios)) {
+        return;
+    }
+    enumerador->frotas++;
+    if (estado->escritor != NULL) {
+        Frota *frota = &enumerador->lote[enumerador->no_lote++];
+        frota->navios = 0;
+        for (int i = 0; i < estado->navios; i++) {
+            int global = tabelas->primeiro + enumerador->indices[i];
+            frota->posicionamento[i] = (uint16_t)global;
+            frota->navios |= posicionamentos[global].mascara;
+        }
+        if (enumerador->no_lote == LOTE_ENUMERACAO) {
+            gravarLoteEnumeracao(enumerador);
+        }
+    }
+}
+
+// Função recursiva da busca: 'candidatos' são os posicionamentos que ainda podem entrar
+// na frota depois dos 'profundidade' já escolhidos em enumerador->indices
+static void explorarFrotas(EnumeradorThread *enumerador, const ConjuntoPosicionamentos *candidatos,
+                           int profundidade) {
+    const EstadoEnumeracao *estado = enumerador->estado;
+    const TabelasEnumeracao *tabelas = estado->tabelas;
+    int restantes = estado->navios - profundidade;
+
+    if (restantes == 0) {
+        if (estado->canonicas) {
+            registrarFrotaEnumerada(enumerador);
+        } else {
+            enumerador->frotas++;
+        }
+        return;
+    }
+    if (restantes == 1 && !estado->canonicas) {
+        enumerador->frotas += (uint64_t)contarPosicionamentos(candidatos); // Último navio: só contar
+        return;
+    }
+
+    for (int w = 0; w < PALAVRAS_POSICIONAMENTOS; w++) {
+        uint64_t bits = candidatos->palavras[w];
+        while (bits) {
+            int p = 64 * w + __builtin_ctzll(bits);
+            ConjuntoPosicionamentos proximos;
+            bits &= bits - 1;
+            intersectarPosicionamentos(&proximos, candidatos, &tabelas->compativeis[p]);
+            int possiveis = contarPosicionamentos(&proximos);
+            if (restantes == 2 && !estado->canonicas) {
+                enumerador->frotas += (uint64_t)possiveis; // Penúltimo navio: cada candidato fecha uma frota
+            } else if (possiveis >= restantes - 1) {
+                enumerador->indices[profundidade] = (uint16_t)p;
+                explorarFrotas(enumerador, &proximos, profundidade + 1);
+            }
+        }
+    }
+}
+
+// Função executada por cada thread: consome tarefas (p0) ou (p0, p1) até acabarem
+static void *trabalhadorEnumeracao(void *argumento) {
+    EstadoEnumeracao *estado = argumento;
+    const TabelasEnumeracao *tabelas = estado->tabelas;
+    int n = tabelas->quantidade;
+    EnumeradorThread *enumerador = malloc(sizeof(EnumeradorThread));
+    long long tarefa;
+
+    if (enumerador == NULL) {
+        atomic_store(&estado->falhou, true);
+        return NULL;
+    }
+    enumerador->estado = estado;
+    enumerador->frotas = 0;
+    enumerador->no_lote = 0;
+
+    while ((tarefa = atomic_fetch_add(&estado->proxima_tarefa, 1)) < estado->total_tarefas) {
+        ConjuntoPosicionamentos candidatos;
+        int p0 = (int)(estado->navios == 1 ? tarefa : tarefa / n);
+        int p1 = (int)(tarefa % n);
+
+        // Na busca canônica, o primeiro navio tem o menor índice da sua órbita e os
+        // demais não podem ter, na órbita, índice menor que o dele
+        if (estado->canonicas && !contemPosicionamento(&tabelas->acima_orbita[p0], p0)) {
+            continue;
+        }
+        enumerador->indices[0] = (uint16_t)p0;
+        if (estado->navios == 1) {
+            memset(&candidatos, 0, sizeof(candidatos));
+            explorarFrotas(enumerador, &candidatos, 1);
+            continue;
+        }
+        if (!contemPosicionamento(&tabelas->compativeis[p0], p1) ||
+            (estado->canonicas && !contemPosicionamento(&tabelas->acima_orbita[p0], p1))) {
+            continue;
+        }
+        enumerador->indices[1] = (uint16_t)p1;
+        intersectarPosicionamentos(&candidatos, &tabelas->compativeis[p0], &tabelas->compativeis[p1]);
+        if (estado->canonicas) {
+            intersectarPosicionamentos(&candidatos, &candidatos, &tabelas->acima_orbita[p0]);
+        }
+        explorarFrotas(enumerador, &candidatos, 2);
+    }
+
+    gravarLoteEnumeracao(enumerador);
+    atomic_fetch_add(&estado->frotas, enumerador->frotas);
+    free(enumerador);
+    return NULL;
+}
+
+// Função auxiliar para executar uma enumeração em 'threads' threads
+// Retorna o número de frotas contadas, ou -1 em caso de erro.
+static long long executarEnumeracao(EstadoEnumeracao *estado, int threads) {
+    pthread_t *ids = malloc((size_t)threads * sizeof(pthread_t));
+    int n = estado->tabelas->quantidade;
+
+    if (ids == NULL) {
+        return -1;
+    }
+    estado->total_tarefas = estado->navios == 1 ? n : (long long)n * n;
+    atomic_init(&estado->proxima_tarefa, 0);
+    atomic_init(&estado->frotas, 0);
+    atomic_init(&estado->falhou, false);
+    pthread_mutex_init(&estado->trava, NULL);
+
+    // A thread atual também trabalha; as demais são criadas aqui
+    int criadas = 0;
+    while (criadas < threads - 1 && pthread_create(&ids[criadas], NULL, trabalhadorEnumeracao, estado) == 0) {
+        criadas++;
+    }
+    trabalhadorEnumeracao(estado);
+    for (int i = 0; i < criadas; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    pthread_mutex_destroy(&estado->trava);
+    free(ids);
+    return atomic_load(&estado->falhou) ? -1 : (long long)atomic_load(&estado->frotas);
+}
+
+// Função para contar todas as frotas de 'navios' navios e as classes de simetria
+// Retorna false para parâmetros inválidos ou falta de memória.
+bool contarFrotas(const TabelasEnumeracao *tabelas, int navios, int threads, ResultadoEnumeracao *resultado) {
+    EstadoEnumeracao estado = {.tabelas = tabelas, .navios = navios, .canonicas = false, .escritor = NULL};
+
+    if (navios < 1 || navios > MAX_NAVIOS_FROTA || threads < 1) {
+        return false;
+    }
+    long long frotas = executarEnumeracao(&estado, threads);
+    if (frotas < 0) {
+        return false;
+    }
+
+    uint64_t soma = resultado->fixas[0] = resultado->frotas = (uint64_t)frotas;
+    for (int g = 1; g < NUM_SIMETRIAS; g++) {
+        resultado->fixas[g] = contarFrotasFixas(tabelas, g, navios);
+        soma += resultado->fixas[g];
+    }
+    resultado->classes = soma / NUM_SIMETRIAS; // Lema de Burnside (a soma é sempre múltipla de 8)
+    return soma % NUM_SIMETRIAS == 0;
+}
+
+// Função para percorrer só as frotas canônicas (uma por classe de simetria), gravando-as
+// em 'escritor' (tipo REGISTRO_NAVIOS, com 'navios' navios por registro) se não for NULL
+// Retorna o número de frotas canônicas, ou -1 em caso de erro. Com várias threads, a
+// ordem dos registros no arquivo depende do escalonamento.
+long long enumerarFrotasCanonicas(const TabelasEnumeracao *tabelas, int navios, int threads,
+                                  EscritorRegistros *escritor) {
+    EstadoEnumeracao estado = {.tabelas = tabelas, .navios = navios, .canonicas = true, .escritor = escritor};
+
+    if (navios < 1 || navios > MAX_NAVIOS_FROTA || threads < 1 ||
+        (escritor != NULL && (escritor->tipo != REGISTRO_NAVIOS || escritor->navios_por_registro != navios))) {
+        return -1;
+    }
+    return executarEnumeracao(&estado, threads);
+}
+
+// --- Tabuleiro com Dimensões em Tempo de Execução ---
+// As funções abaixo têm a mesma semântica de canPlaceShip, placeShip e aplicarHabilidadeAoTabuleiro,
+// mas para um Tabuleiro de qualquer dimensão (a exibição, exibirTabuleiroDinamico, fica no programa
+// de linha de comando). Cada operação é escrita uma vez
+// como função 'static inline' que recebe as dimensões; as versões especializadas apenas a chamam
+// com dimensões constantes, para que o compilador gere o mesmo código de um array de tamanho fixo.
+
+// Função para preencher todas as células do tabuleiro com água
+void limparTabuleiro(Tabuleiro *tabuleiro) {
+    int total = tabuleiro->linhas * tabuleiro->colunas;
+    for (int i = 0; i < total; i++) {
+        tabuleiro->celulas[i] = VALOR_AGUA;
+    }
+}
+
+// Função para iniciar um tabuleiro de 'linhas' x 'colunas' com água sobre a memória do chamador
+// 'celulas' deve ter linhas * colunas inteiros e continuar válido enquanto o tabuleiro for usado.
+// Retorna false se as dimensões forem inválidas.
+bool iniciarTabuleiro(Tabuleiro *tabuleiro, int linhas, int colunas, int *celulas) {
+    tabuleiro->celulas = NULL;
+    if (linhas < 1 || linhas > TABULEIRO_DINAMICO_MAX || colunas < 1 || colunas > TABULEIRO_DINAMICO_MAX ||
+        celulas == NULL) {
+        return false;
+    }
+
+    tabuleiro->celulas = celulas;
+    tabuleiro->linhas = linhas;
+    tabuleiro->colunas = colunas;
+    if (linhas == 10 && colunas == 10) {
+        tabuleiro->forma = FORMA_10X10;
+    } else if (linhas == 16 && colunas == 16) {
+        tabuleiro->forma = FORMA_16X16;
+    } else {
+        tabuleiro->forma = FORMA_GENERICA;
+    }
+    limparTabuleiro(tabuleiro);
+    return true;
+}
+
+// Função para criar um tabuleiro de 'linhas' x 'colunas' inicializado com água
+// As células são alocadas aqui e liberadas por liberarTabuleiro.
+// Retorna false se as dimensões forem inválidas ou a alocação falhar.
+bool criarTabuleiro(Tabuleiro *tabuleiro, int linhas, int colunas) {
+    tabuleiro->celulas = NULL;
+    if (linhas < 1 || linhas > TABULEIRO_DINAMICO_MAX || colunas < 1 || colunas > TABULEIRO_DINAMICO_MAX) {
+        return false;
+    }
+
+    int *celulas = malloc((size_t)linhas * (size_t)colunas * sizeof(int));
+    if (!iniciarTabuleiro(tabuleiro, linhas, colunas, celulas)) {
+        free(celulas);
+        return false;
+    }
+    return true;
+}
+
+// Função para liberar a memória de um tabuleiro criado por criarTabuleiro
+void liberarTabuleiro(Tabuleiro *tabuleiro) {
+    free(tabuleiro->celulas);
+    tabuleiro->celulas = NULL;
+}
+
+// Implementação genérica de canPlaceShip para um tabuleiro linhas x colunas
+// Os limites são verificados uma única vez pelas duas pontas do navio (as células são colineares);
+// depois as células são percorridas com passo fixo, sem cálculo de coordenadas.
+static inline bool podePosicionarDimensoes(const int *celulas, int linhas, int colunas,
+                                           int start_row, int start_col, int size, OrientacaoNavio orientation) {
+    int dr, dc;
+
+    if (size <= 0) {
+        return true; // Nenhuma célula a verificar, como em canPlaceShip
+    }
+    if (!deslocamentoOrientacao(orientation, &dr, &dc)) {
+        return false;
+    }
+
+    int r_fim = start_row + dr * (size - 1);
+    int c_fim = start_col + dc * (size - 1);
+    if (start_row < 0 || start_row >= linhas || start_col < 0 || start_col >= colunas ||
+        r_fim < 0 || r_fim >= linhas || c_fim >= colunas) {
+        return false; // Fora dos limites do tabuleiro
+    }
+
+    const int *celula = celulas + start_row * colunas + start_col;
+    int passo = dr * colunas + dc;
+    for (int i = 0; i < size; i++) {
+        if (celula[i * passo] != VALOR_AGUA) {
+            return false; // Sobreposição detectada
+        }
+    }
+    return true;
+}
+
+// Implementação genérica de placeShip para um tabuleiro linhas x colunas
+static inline void posicionarDimensoes(int *celulas, int colunas,
+                                       int start_row, int start_col, int size, OrientacaoNavio orientation) {
+    int dr, dc;
+
+    if (!deslocamentoOrientacao(orientation, &dr, &dc)) {
+        return;
+    }
+
+    int *celula = celulas + start_row * colunas + start_col;
+    int passo = dr * colunas + dc;
+    for (int i = 0; i < size; i++) {
+        celula[i * passo] = VALOR_NAVIO;
+    }
+}
+
+// Função para verificar se um navio pode ser posicionado em um Tabuleiro (ver canPlaceShip)
+bool canPlaceShipTabuleiro(const Tabuleiro *tabuleiro,
+                           int start_row, int start_col, int size, OrientacaoNavio orientation) {
+    switch (tabuleiro->forma) {
+        case FORMA_10X10:
+            return podePosicionarDimensoes(tabuleiro->celulas, 10, 10, start_row, start_col, size, orientation);
+        case FORMA_16X16:
+            return podePosicionarDimensoes(tabuleiro->celulas, 16, 16, start_row, start_col, size, orientation);
+        default:
+            return podePosicionarDimensoes(tabuleiro->celulas, tabuleiro->linhas, tabuleiro->colunas,
+                                           start_row, start_col, size, orientation);
+    }
+}
+
+// Função para posicionar um navio em um Tabuleiro (ver placeShip)
+// Assume que canPlaceShipTabuleiro já confirmou o posicionamento.
+void placeShipTabuleiro(Tabuleiro *tabuleiro,
+                        int start_row, int start_col, int size, OrientacaoNavio orientation) {
+    switch (tabuleiro->forma) {
+        case FORMA_10X10:
+            posicionarDimensoes(tabuleiro->celulas, 10, start_row, start_col, size, orientation);
+            break;
+        case FORMA_16X16:
+            posicionarDimensoes(tabuleiro->celulas, 16, start_row, start_col, size, orientation);
+            break;
+        default:
+            posicionarDimensoes(tabuleiro->celulas, tabuleiro->colunas, start_row, start_col, size, orientation);
+            break;
+    }
+}
+
+// Implementação genérica de aplicarHabilidadeAoTabuleiro para um tabuleiro linhas x colunas
+// A matriz de habilidade tem 'tamanho' x 'tamanho' células, linha a linha, centrada na origem.
+static inline void aplicarHabilidadeDimensoes(int *celulas, int linhas, int colunas,
+                                              const int *matriz, int tamanho, int origin_row, int origin_col) {
+    int centro = tamanho / 2;
+
+    for (int r_hab = 0; r_hab < tamanho; r_hab++) {
+        int r_tab = origin_row + (r_hab - centro);
+        if (r_tab < 0 || r_tab >= linhas) {
+            continue; // Linha inteira fora do tabuleiro
+        }
+        for (int c_hab = 0; c_hab < tamanho; c_hab++) {
+            int c_tab = origin_col + (c_hab - centro);
+            if (matriz[r_hab * tamanho + c_hab] == 1 && c_tab >= 0 && c_tab < colunas &&
+                celulas[r_tab * colunas + c_tab] == VALOR_AGUA) {
+                celulas[r_tab * colunas + c_tab] = VALOR_HABILIDADE;
+            }
+        }
+    }
+}
+
+// Função para aplicar uma habilidade a um Tabuleiro (ver aplicarHabilidadeAoTabuleiro)
+// 'matriz' tem 'tamanho' x 'tamanho' valores, linha a linha; o centro fica em tamanho / 2.
+void aplicarHabilidadeTabuleiro(Tabuleiro *tabuleiro, const int *matriz, int tamanho,
+                                int origin_row, int origin_col) {
+    switch (tabuleiro->forma) {
+        case FORMA_10X10:
+            aplicarHabilidadeDimensoes(tabuleiro->celulas, 10, 10, matriz, tamanho, origin_row, origin_col);
+            break;
+        case FORMA_16X16:
+            aplicarHabilidadeDimensoes(tabuleiro->celulas, 16, 16, matriz, tamanho, origin_row, origin_col);
+            break;
+        default:
+            aplicarHabilidadeDimensoes(tabuleiro->celulas, tabuleiro->linhas, tabuleiro->colunas,
+                                       matriz, tamanho, origin_row, origin_col);
+            break;
+    }
+}
+
+// --- Motor de Movimento das Peças ---
+// As casas que Torre, Bispo e Rainha alcançam são uniões de raios pré-calculados, cortados no
+// primeiro bloqueio com uma busca de bit (raioLivre); as do Cavalo vêm de uma tabela de saltos.
+// Nada é alocado e não há recursão: um caminho é gravado em um vetor fornecido por quem chama.
+
+Bitboard raios_movimento[NUM_DIRECOES][TABULEIRO_CELULAS];
+Bitboard saltos_cavalo[TABULEIRO_CELULAS];
+
+// Função para obter o deslocamento (linha, coluna) de cada passo de uma direção
+void deslocamentoDirecao(DirecaoMovimento direcao, int *delta_row, int *delta_col) {
+    static const int8_t deslocamentos[NUM_DIRECOES][2] = {
+        {0, 1}, {1, 0}, {1, 1}, {1, -1}, {0, -1}, {-1, 0}, {-1, -1}, {-1, 1}
+    };
+    *delta_row = deslocamentos[direcao][0];
+    *delta_col = deslocamentos[direcao][1];
+}
+
+// Função para preencher os raios de movimento e os saltos do Cavalo (chamada por inicializarBitboards)
+static void inicializarMovimentos(void) {
+    static const int8_t saltos[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+
+    for (int row = 0; row < TABULEIRO_TAMANHO; row++) {
+        for (int col = 0; col < TABULEIRO_TAMANHO; col++) {
+            int celula = row * TABULEIRO_TAMANHO + col;
+
+            for (int direcao = 0; direcao < NUM_DIRECOES; direcao++) {
+                int delta_row, delta_col;
+                Bitboard raio = 0;
+
+                deslocamentoDirecao((DirecaoMovimento)direcao, &delta_row, &delta_col);
+                for (int r = row + delta_row, c = col + delta_col;
+                     r >= 0 && r < TABULEIRO_TAMANHO && c >= 0 && c < TABULEIRO_TAMANHO;
+                     r += delta_row, c += delta_col) {
+                    raio |= BITBOARD_CELULA(r, c);
+                }
+                raios_movimento[direcao][celula] = raio;
+            }
+
+            saltos_cavalo[celula] = 0;
+            for (int s = 0; s < 8; s++) {
+                int r = row + saltos[s][0], c = col + saltos[s][1];
+                if (r >= 0 && r < TABULEIRO_TAMANHO && c >= 0 && c < TABULEIRO_TAMANHO) {
+                    saltos_cavalo[celula] |= BITBOARD_CELULA(r, c);
+                }
+            }
+        }
+    }
+}
+
+// Função para gerar o caminho de uma peça que anda 'passos' casas em uma direção
+// Grava em 'casas' (com espaço para TABULEIRO_TAMANHO - 1 células), na ordem em que são visitadas,
+// as células do percurso; o caminho termina antes da borda ou do primeiro bloqueio.
+// Retorna a quantidade de casas visitadas (menor que 'passos' quando o caminho foi interrompido).
+int caminhoPeca(int celula, DirecaoMovimento direcao, int passos, Bitboard bloqueios, uint8_t casas[]) {
+    Bitboard livres = raioLivre(direcao, celula, bloqueios);
+    int visitadas = 0;
+
+    while (visitadas < passos && livres) {
+        if (direcao < DIRECOES_CRESCENTES) {
+            casas[visitadas++] = (uint8_t)extrairCelula(&livres);
+        } else {
+            int proxima = maiorCelula(livres);
+            livres &= ~((Bitboard)1 << proxima);
+            casas[visitadas++] = (uint8_t)proxima;
+        }
+    }
+    return visitadas;
+}
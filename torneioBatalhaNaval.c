@@ -0,0 +1,355 @@
+// Torneio entre estratégias de tiro e de posicionamento (parte da biblioteca libbatalhanaval.a)
+// Joga partidas completas entre dois jogadores (ver batalhaNaval.h) e soma vitórias por jogador.
+//
+// Cada partida depende apenas de (semente, número da partida): o gerador é semeado por partida,
+// e o jogador que começa alterna com a paridade do número. As partidas são divididas em blocos
+// de BLOCO_TORNEIO; as threads pegam o próximo bloco de um contador atômico, jogam na própria
+// arena (sem alocação por partida), acumulam em contadores locais e só no final somam ao
+// resultado com adições atômicas. O resultado, portanto, não depende do número de threads.
+
+#include <stdlib.h>    // Para malloc/free
+#include <string.h>    // Para memset
+#include <math.h>      // Para sqrt no intervalo de Wilson
+#include <pthread.h>   // Para as threads do torneio
+#include <stdatomic.h> // Para contadores compartilhados sem trava
+
+#include "batalhaNaval.h"
+
+#define MAX_TENTATIVAS_NAVIO 256   // Sorteios de posição por navio antes de recomeçar a frota
+#define MAX_RECOMECOS_FROTA 100    // Recomeços da frota antes de desistir da partida
+#define TENTATIVAS_BORDA 64        // Sorteios na borda antes de aceitar qualquer posição reta
+
+// --- Arena e Posicionamento da Frota ---
+
+// Função para preparar a arena de uma thread: matrizes e carimbos de cada disparo
+// O tiro simples é uma matriz de habilidade com apenas o centro marcado.
+void prepararArenaTorneio(ArenaTorneio *arena) {
+    memset(arena, 0, sizeof(*arena));
+    arena->matrizes[DISPARO_TIRO][HABILIDADE_CENTRO][HABILIDADE_CENTRO] = 1;
+    criarHabilidadeCone(arena->matrizes[1 + HABILIDADE_CONE]);
+    criarHabilidadeCruz(arena->matrizes[1 + HABILIDADE_CRUZ]);
+    criarHabilidadeOctaedro(arena->matrizes[1 + HABILIDADE_OCTAEDRO]);
+
+    for (int d = 0; d < NUM_DISPAROS; d++) {
+        MascaraHabilidade mascara = compactarHabilidade(arena->matrizes[d]);
+        for (int origem = 0; origem < TABULEIRO_CELULAS; origem++) {
+            arena->carimbos[d][origem] = carimboHabilidade(mascara, origem / TABULEIRO_TAMANHO,
+                                                           origem % TABULEIRO_TAMANHO);
+        }
+    }
+    for (int r = 0; r < TABULEIRO_TAMANHO; r++) {
+        for (int c = (r & 1); c < TABULEIRO_TAMANHO; c += 2) {
+            arena->paridade |= BITBOARD_CELULA(r, c);
+        }
+        for (int c = 0; c < TABULEIRO_TAMANHO; c++) {
+            if (!(r & 1) || !(c & 1)) {
+                arena->paridade_diagonal |= BITBOARD_CELULA(r, c);
+            }
+        }
+    }
+}
+
+// Função auxiliar para sortear uma posição de navio segundo a estratégia
+// 'tentativa' é o número do sorteio atual do navio (a estratégia das bordas desiste da borda
+// depois de TENTATIVAS_BORDA sorteios).
+static void sortearPosicaoNavio(GeradorAleatorio *gerador, EstrategiaPosicionamento estrategia, int size,
+                                int tentativa, int *row, int *col, OrientacaoNavio *orientation) {
+    if (estrategia == POSICIONAMENTO_ALEATORIO) {
+        *row = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO);
+        *col = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO);
+        *orientation = (OrientacaoNavio)aleatorioAte(gerador, NUM_ORIENTACOES);
+        return;
+    }
+
+    *orientation = aleatorioAte(gerador, 2) ? VERTICAL : HORIZONTAL;
+    if (estrategia == POSICIONAMENTO_BORDAS && tentativa < TENTATIVAS_BORDA) {
+        // Encostado em uma das duas bordas paralelas ao navio, sempre dentro dos limites
+        int borda = aleatorioAte(gerador, 2) ? TABULEIRO_TAMANHO - 1 : 0;
+        int inicio = (int)aleatorioAte(gerador, (uint32_t)(TABULEIRO_TAMANHO - size + 1));
+        *row = *orientation == HORIZONTAL ? borda : inicio;
+        *col = *orientation == HORIZONTAL ? inicio : borda;
+        return;
+    }
+    *row = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO);
+    *col = (int)aleatorioAte(gerador, TABULEIRO_TAMANHO);
+}
+
+// Função para posicionar a frota de um jogador no próprio tabuleiro com canPlaceShip/placeShip
+// Posições recusadas são sorteadas de novo; se um navio não couber, a frota recomeça.
+// Retorna false se a frota não pôde ser posicionada.
+static bool posicionarFrotaTorneio(GeradorAleatorio *gerador, const ConfiguracaoFrota *frota,
+                                   EstrategiaPosicionamento estrategia, JogadorTorneio *jogador) {
+    for (int recomeco = 0; recomeco < MAX_RECOMECOS_FROTA; recomeco++) {
+        bool completa = true;
+
+        memset(jogador->tabuleiro, 0, sizeof(jogador->tabuleiro));
+        jogador->navios = 0;
+        for (int i = 0; i < frota->quantidade_navios && completa; i++) {
+            int size = frota->tamanhos[i];
+            int tentativa = 0;
+
+            for (; tentativa < MAX_TENTATIVAS_NAVIO; tentativa++) {
+                int row, col;
+                OrientacaoNavio orientation;
+
+                sortearPosicaoNavio(gerador, estrategia, size, tentativa, &row, &col, &orientation);
+                if (canPlaceShip(jogador->tabuleiro, row, col, size, orientation)) {
+                    placeShip(jogador->tabuleiro, row, col, size, orientation);
+                    jogador->cascos[i] = mascaraNavio(row, col, size, orientation);
+                    jogador->navios |= jogador->cascos[i];
+                    break;
+                }
+            }
+            completa = tentativa < MAX_TENTATIVAS_NAVIO;
+        }
+        if (completa) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- Partidas ---
+
+// Função auxiliar para sortear uma célula de um bitboard não vazio
+static inline int sortearCelula(GeradorAleatorio *gerador, Bitboard celulas) {
+    int baixas = __builtin_popcountll((uint64_t)celulas);
+    int ordem = (int)aleatorioAte(gerador, (uint32_t)contarBits(celulas));
+
+    return ordem < baixas ? selecionarBit((uint64_t)celulas, ordem)
+                          : 64 + selecionarBit((uint64_t)(celulas >> 64), ordem - baixas);
+}
+
+// Função auxiliar para obter as vizinhas das células de um bitboard
+// Com 'diagonais', inclui as vizinhas diagonais (deslocando para os lados as vizinhas verticais).
+// As colunas das bordas vêm dos raios do motor de movimento (coluna 0 descendo a partir de (0,0)).
+static inline Bitboard vizinhasCelulas(Bitboard celulas, bool diagonais) {
+    Bitboard coluna_esquerda = raios_movimento[DIRECAO_BAIXO][0] | BITBOARD_CELULA(0, 0);
+    Bitboard coluna_direita = coluna_esquerda << (TABULEIRO_TAMANHO - 1);
+    Bitboard verticais = (celulas << TABULEIRO_TAMANHO) | (celulas >> TABULEIRO_TAMANHO);
+    Bitboard linha = celulas;
+
+    if (diagonais) {
+        linha |= verticais;
+    }
+    return ((linha & ~coluna_direita) << 1) | ((linha & ~coluna_esquerda) >> 1) | verticais;
+}
+
+// Função para fazer um disparo do 'atacante' no tabuleiro do 'alvo'
+// A origem sai da estratégia de tiro; enquanto não há navio atingido e não afundado para
+// perseguir, as cargas de habilidade são gastas (octaedro, depois cruz, depois cone).
+// 'diagonais' indica se o posicionamento do alvo admite navios diagonais: a caça passa a
+// incluir as vizinhas diagonais e a paridade usa a máscara que também cobre os cascos diagonais.
+static void dispararTorneio(ArenaTorneio *arena, GeradorAleatorio *gerador, EstrategiaTiro estrategia,
+                            bool diagonais, int navios, JogadorTorneio *atacante, JogadorTorneio *alvo) {
+    static const int ordem_habilidades[NUM_HABILIDADES_PADRAO] = {
+        HABILIDADE_OCTAEDRO, HABILIDADE_CRUZ, HABILIDADE_CONE
+    };
+    Bitboard livres = ~(alvo->cobertas | BITBOARD_GUARDA);
+    Bitboard candidatas = 0;
+
+    if (estrategia != TIRO_ALEATORIO) {
+        Bitboard abertos = 0; // Acertos em navios ainda não afundados
+        for (int i = 0; i < navios; i++) {
+            if (alvo->cascos[i] & ~alvo->atingidos) {
+                abertos |= alvo->cascos[i] & alvo->atingidos;
+            }
+        }
+        candidatas = vizinhasCelulas(abertos, diagonais) & livres;
+    }
+
+    int disparo = DISPARO_TIRO;
+    if (!candidatas) {
+        candidatas = livres;
+        Bitboard paridade = diagonais ? arena->paridade_diagonal : arena->paridade;
+        if (estrategia == TIRO_PARIDADE && (livres & paridade)) {
+            candidatas &= paridade;
+        }
+        for (int h = 0; h < NUM_HABILIDADES_PADRAO; h++) {
+            if (atacante->cargas[ordem_habilidades[h]] > 0) {
+                atacante->cargas[ordem_habilidades[h]]--;
+                disparo = 1 + ordem_habilidades[h];
+                break;
+            }
+        }
+    }
+
+    int origem = sortearCelula(gerador, candidatas);
+    Bitboard carimbo = arena->carimbos[disparo][origem];
+
+    aplicarHabilidadeAoTabuleiro(alvo->tabuleiro, arena->matrizes[disparo],
+                                 origem / TABULEIRO_TAMANHO, origem % TABULEIRO_TAMANHO);
+    alvo->cobertas |= carimbo;
+    alvo->atingidos |= carimbo & alvo->navios;
+    atacante->disparos++;
+}
+
+// Função para jogar a partida de número 'partida' do torneio na arena
+// A partida é determinada por (config->semente, partida); o jogador partida % 2 dispara primeiro.
+// Ao final a arena guarda o estado dos dois jogadores. Retorna o vencedor (0 ou 1), ou -1 se
+// alguma frota não pôde ser posicionada.
+int jogarPartidaTorneio(const ConfiguracaoTorneio *config, ArenaTorneio *arena, uint64_t partida) {
+    GeradorAleatorio gerador;
+
+    semearGerador(&gerador, config->semente ^ (partida * 0x9E3779B97F4A7C15ULL));
+    for (int j = 0; j < 2; j++) {
+        JogadorTorneio *jogador = &arena->jogadores[j];
+        if (!posicionarFrotaTorneio(&gerador, &config->frota, config->jogadores[j].posicionamento, jogador)) {
+            return -1;
+        }
+        jogador->cobertas = 0;
+        jogador->atingidos = 0;
+        jogador->disparos = 0;
+        for (int h = 0; h < NUM_HABILIDADES_PADRAO; h++) {
+            jogador->cargas[h] = config->cargas_habilidade;
+        }
+    }
+
+    // Cada disparo cobre ao menos uma célula nova, então a partida termina em até 100 disparos
+    // por jogador (frotas sem navios terminam no primeiro)
+    int vez = (int)(partida & 1);
+    for (;;) {
+        JogadorTorneio *alvo = &arena->jogadores[1 - vez];
+        bool diagonais = config->jogadores[1 - vez].posicionamento == POSICIONAMENTO_ALEATORIO;
+        dispararTorneio(arena, &gerador, config->jogadores[vez].tiro, diagonais,
+                        config->frota.quantidade_navios, &arena->jogadores[vez], alvo);
+        if (!(alvo->navios & ~alvo->atingidos)) {
+            return vez;
+        }
+        vez = 1 - vez;
+    }
+}
+
+// --- Execução em Paralelo ---
+
+// Estado compartilhado entre as threads de um torneio
+typedef struct {
+    const ConfiguracaoTorneio *config;
+    long long total_blocos;
+    atomic_llong proximo_bloco;
+    atomic_llong partidas;
+    atomic_uint_least64_t vitorias[2];
+    atomic_uint_least64_t vitorias_iniciando[2];
+    atomic_uint_least64_t disparos_vencedor;
+    atomic_bool falhou; // Frota impossível de posicionar
+} EstadoTorneio;
+
+// Função executada por cada thread do torneio
+static void *trabalhadorTorneio(void *argumento) {
+    EstadoTorneio *estado = argumento;
+    const ConfiguracaoTorneio *config = estado->config;
+    ArenaTorneio *arena = malloc(sizeof(ArenaTorneio)); // Uma por thread, reaproveitada
+    uint64_t vitorias[2] = {0, 0}, vitorias_iniciando[2] = {0, 0}, disparos_vencedor = 0;
+    long long partidas = 0;
+    long long bloco;
+
+    if (arena == NULL) {
+        atomic_store(&estado->falhou, true);
+        return NULL;
+    }
+    prepararArenaTorneio(arena);
+
+    while (!atomic_load_explicit(&estado->falhou, memory_order_relaxed) &&
+           (bloco = atomic_fetch_add(&estado->proximo_bloco, 1)) < estado->total_blocos) {
+        long long inicio = bloco * BLOCO_TORNEIO;
+        long long fim = MINIMO(inicio + BLOCO_TORNEIO, config->partidas);
+        long long i = inicio;
+
+        for (; i < fim; i++) {
+            int vencedor = jogarPartidaTorneio(config, arena, (uint64_t)i);
+            if (vencedor < 0) {
+                atomic_store(&estado->falhou, true);
+                break;
+            }
+            vitorias[vencedor]++;
+            vitorias_iniciando[vencedor] += (uint64_t)((i & 1) == vencedor);
+            disparos_vencedor += (uint64_t)arena->jogadores[vencedor].disparos;
+        }
+        partidas += i - inicio; // Só as partidas jogadas até uma eventual falha
+    }
+
+    // Junção sem trava: cada contador recebe uma única adição atômica por thread
+    for (int j = 0; j < 2; j++) {
+        atomic_fetch_add_explicit(&estado->vitorias[j], vitorias[j], memory_order_relaxed);
+        atomic_fetch_add_explicit(&estado->vitorias_iniciando[j], vitorias_iniciando[j], memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&estado->disparos_vencedor, disparos_vencedor, memory_order_relaxed);
+    atomic_fetch_add(&estado->partidas, partidas);
+    free(arena);
+    return NULL;
+}
+
+// Função para executar o torneio em 'config->threads' threads
+// Retorna false se a configuração for inválida, uma frota não puder ser posicionada ou faltar memória.
+bool executarTorneio(const ConfiguracaoTorneio *config, ResultadoTorneio *resultado) {
+    if (config->threads < 1 || config->partidas < 0 || config->cargas_habilidade < 0 ||
+        !configuracaoFrotaValida(&config->frota)) {
+        return false;
+    }
+    for (int j = 0; j < 2; j++) {
+        if ((unsigned)config->jogadores[j].tiro >= NUM_ESTRATEGIAS_TIRO ||
+            (unsigned)config->jogadores[j].posicionamento >= NUM_ESTRATEGIAS_POSICIONAMENTO) {
+            return false;
+        }
+    }
+
+    EstadoTorneio *estado = malloc(sizeof(EstadoTorneio));
+    pthread_t *threads = malloc((size_t)config->threads * sizeof(pthread_t));
+    if (estado == NULL || threads == NULL) {
+        free(estado);
+        free(threads);
+        return false;
+    }
+
+    estado->config = config;
+    estado->total_blocos = (config->partidas + BLOCO_TORNEIO - 1) / BLOCO_TORNEIO;
+    atomic_init(&estado->proximo_bloco, 0);
+    atomic_init(&estado->partidas, 0);
+    atomic_init(&estado->disparos_vencedor, 0);
+    atomic_init(&estado->falhou, false);
+    for (int j = 0; j < 2; j++) {
+        atomic_init(&estado->vitorias[j], 0);
+        atomic_init(&estado->vitorias_iniciando[j], 0);
+    }
+
+    // A thread atual também trabalha; as demais são criadas aqui
+    int criadas = 0;
+    while (criadas < config->threads - 1 &&
+           pthread_create(&threads[criadas], NULL, trabalhadorTorneio, estado) == 0) {
+        criadas++;
+    }
+    trabalhadorTorneio(estado);
+    for (int i = 0; i < criadas; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    bool sucesso = !atomic_load(&estado->falhou);
+    resultado->partidas = atomic_load(&estado->partidas);
+    resultado->disparos_vencedor = atomic_load(&estado->disparos_vencedor);
+    for (int j = 0; j < 2; j++) {
+        resultado->vitorias[j] = atomic_load(&estado->vitorias[j]);
+        resultado->vitorias_iniciando[j] = atomic_load(&estado->vitorias_iniciando[j]);
+    }
+    free(threads);
+    free(estado);
+    return sucesso;
+}
+
+// Função para calcular o intervalo de confiança de Wilson de uma proporção
+// 'z' é o quantil da normal (1.96 para 95%). Sem ensaios, o intervalo é [0, 1].
+void intervaloWilson(uint64_t sucessos, uint64_t total, double z, double *inferior, double *superior) {
+    if (total == 0) {
+        *inferior = 0.0;
+        *superior = 1.0;
+        return;
+    }
+    double n = (double)total;
+    double p = (double)sucessos / n;
+    double z2 = z * z;
+    double denominador = 1.0 + z2 / n;
+    double centro = (p + z2 / (2.0 * n)) / denominador;
+    double margem = z * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / denominador;
+
+    *inferior = centro - margem < 0.0 ? 0.0 : centro - margem;
+    *superior = centro + margem > 1.0 ? 1.0 : centro + margem;
+}